@@ -0,0 +1,34 @@
+#
+# Report the cost of hot kernel functions relocated to SRAM
+#
+# Usage: cmake -DSIZE=<arm-none-eabi-size> -DNM=<arm-none-eabi-nm> -DKERNEL=<kernel> -P RamFunctionReport.cmake
+#
+# @note Functions in the `.ramfunc` section occupy the same amount of space in the flash (load image) and in SRAM.
+#
+execute_process(COMMAND ${SIZE} -A -d ${KERNEL} OUTPUT_VARIABLE SECTIONS)
+
+if (NOT SECTIONS MATCHES "\n\\.ramfunc +([0-9]+) +([0-9]+)")
+    message(STATUS "The kernel does not contain any RAM functions.")
+    return()
+endif()
+
+set(RAMFUNC_SIZE ${CMAKE_MATCH_1})
+set(RAMFUNC_START ${CMAKE_MATCH_2})
+math(EXPR RAMFUNC_END "${RAMFUNC_START} + ${RAMFUNC_SIZE}")
+
+message(STATUS "RAM functions occupy ${RAMFUNC_SIZE} bytes of SRAM:")
+
+if (NM)
+    # Each line looks like `20000100 00000124 T switchTask`
+    execute_process(COMMAND ${NM} -S -C --size-sort ${KERNEL} OUTPUT_VARIABLE SYMBOLS)
+    string(REPLACE "\n" ";" SYMBOLS "${SYMBOLS}")
+    foreach (SYMBOL ${SYMBOLS})
+        if (SYMBOL MATCHES "^([0-9a-fA-F]+) ([0-9a-fA-F]+) [tTwW] (.+)$")
+            math(EXPR ADDRESS "0x${CMAKE_MATCH_1}")
+            math(EXPR BYTES "0x${CMAKE_MATCH_2}")
+            if (ADDRESS GREATER_EQUAL RAMFUNC_START AND ADDRESS LESS RAMFUNC_END)
+                message(STATUS "    ${BYTES}\t${CMAKE_MATCH_3}")
+            endif()
+        endif()
+    endforeach()
+endif()
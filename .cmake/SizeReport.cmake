@@ -0,0 +1,277 @@
+#
+# Report the flash and SRAM usage of the kernel and enforce the size budget
+#
+# Usage: cmake -DSIZE=<arm-none-eabi-size> -DKERNEL=<kernel> -DMAP=<kernel.map> -DBASELINE=<baseline.cmake>
+#              -DFLASH_BUDGET=<bytes> -DRAM_BUDGET=<bytes> [-DSECTION_BUDGETS=<.section=bytes,...>]
+#              [-DCXXFILT=<arm-none-eabi-c++filt>] [-DTOP_SYMBOLS=<count>] [-DUPDATE_BASELINE=ON]
+#              -P SizeReport.cmake
+#
+# @note The report breaks down the usage by section, by object file, by Tinkertoy module and by symbol.
+# @note Sections that are loaded from the flash and run in SRAM (i.e. `.data` and `.ramfunc`) count towards both budgets.
+# @note The SRAM usage includes the kernel stack, the reserved part of the heap and the user memory.
+# @note The build fails if any budget is exceeded.
+#       If `UPDATE_BASELINE` is set, the current usage is saved as the new baseline instead.
+#
+cmake_minimum_required(VERSION 3.15)
+
+if (NOT TOP_SYMBOLS)
+    set(TOP_SYMBOLS 20)
+endif()
+
+# Output sections that are stored in the flash, in SRAM or in both
+set(FLASH_SECTIONS .bootloader .text .rodata .preinit_array .init_array .fini_array)
+set(SHARED_SECTIONS .data .ramfunc)
+# The kernel stack, the reserved part of the heap and the user memory are sections as well (See `Kernel.ld`),
+# so that the SRAM usage accounts for all memory the kernel needs at run time.
+set(RAM_SECTIONS .kernel.isr_table .bss .retained .stack .heap .userstack .userdata)
+
+# Tinkertoy modules are mostly header-only templates instantiated in the kernel objects,
+# so symbols are attributed to a module by matching their (mangled) names.
+set(MODULES Scheduler MemoryAllocator Execution TinkerLibrary)
+set(MODULE_PATTERN_Scheduler "Scheduler")
+set(MODULE_PATTERN_MemoryAllocator "Allocator|Aligner")
+set(MODULE_PATTERN_Execution "Dispatcher|KernelServiceRoutines|TaskControlBlockComponents|EventController|EventHandlerTrampoline")
+set(MODULE_PATTERN_TinkerLibrary "printf|_ntoa|_ftoa|_etoa|_out_|mem(set|cpy|move|cmp)|strlen|panic|BitOptions")
+
+# Pad the given number with leading zeros so that lists can be sorted numerically
+function(pad_number NUMBER OUTPUT)
+    string(LENGTH "${NUMBER}" LENGTH)
+    math(EXPR ZEROS "10 - ${LENGTH}")
+    string(REPEAT "0" ${ZEROS} PADDING)
+    set(${OUTPUT} "${PADDING}${NUMBER}" PARENT_SCOPE)
+endfunction()
+
+# Print the difference between the given value and its baseline
+function(print_usage NAME VALUE BASELINE_VALUE)
+    if (DEFINED BASELINE_VALUE AND NOT BASELINE_VALUE STREQUAL "")
+        math(EXPR DELTA "${VALUE} - ${BASELINE_VALUE}")
+        if (DELTA GREATER 0)
+            set(DELTA "+${DELTA}")
+        endif()
+        message(STATUS "    ${NAME}: ${VALUE} bytes (${DELTA} bytes since baseline)")
+    else()
+        message(STATUS "    ${NAME}: ${VALUE} bytes")
+    endif()
+endfunction()
+
+#
+# MARK: Usage by section
+#
+
+execute_process(COMMAND ${SIZE} -A -d ${KERNEL} OUTPUT_VARIABLE SIZE_OUTPUT RESULT_VARIABLE RESULT)
+if (NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "Failed to read the sections of ${KERNEL}.")
+endif()
+
+set(FLASH_USAGE 0)
+set(RAM_USAGE 0)
+set(SECTIONS)
+string(REPLACE "\n" ";" SIZE_OUTPUT "${SIZE_OUTPUT}")
+foreach (LINE ${SIZE_OUTPUT})
+    if (LINE MATCHES "^(\\.[^ ]+) +([0-9]+) +([0-9]+)")
+        set(NAME ${CMAKE_MATCH_1})
+        set(BYTES ${CMAKE_MATCH_2})
+        if (NAME IN_LIST FLASH_SECTIONS)
+            math(EXPR FLASH_USAGE "${FLASH_USAGE} + ${BYTES}")
+        elseif (NAME IN_LIST SHARED_SECTIONS)
+            math(EXPR FLASH_USAGE "${FLASH_USAGE} + ${BYTES}")
+            math(EXPR RAM_USAGE "${RAM_USAGE} + ${BYTES}")
+        elseif (NAME IN_LIST RAM_SECTIONS)
+            math(EXPR RAM_USAGE "${RAM_USAGE} + ${BYTES}")
+        else()
+            # Debug information and attributes
+            continue()
+        endif()
+        list(APPEND SECTIONS ${NAME})
+        set(SECTION_${NAME} ${BYTES})
+    endif()
+endforeach()
+
+#
+# MARK: Usage by object file, module and symbol
+#
+
+set(OBJECTS)
+set(SYMBOLS)
+foreach (MODULE ${MODULES} Kernel)
+    set(MODULE_FLASH_${MODULE} 0)
+    set(MODULE_RAM_${MODULE} 0)
+endforeach()
+
+# Attribute an input section to its object file, its module and its symbol
+macro(account_input_section SECTION_NAME BYTES_HEX OBJECT)
+    math(EXPR BYTES "${BYTES_HEX}")
+    if (BYTES GREATER 0)
+        if (OUTPUT_SECTION IN_LIST FLASH_SECTIONS)
+            set(IN_FLASH ON)
+            set(IN_RAM OFF)
+        elseif (OUTPUT_SECTION IN_LIST SHARED_SECTIONS)
+            set(IN_FLASH ON)
+            set(IN_RAM ON)
+        else()
+            set(IN_FLASH OFF)
+            set(IN_RAM ON)
+        endif()
+
+        # Object file
+        string(REGEX REPLACE "^.*CMakeFiles/[^/]+\\.dir/" "" OBJECT_NAME "${OBJECT}")
+        string(MAKE_C_IDENTIFIER "${OBJECT_NAME}" OBJECT_ID)
+        if (NOT DEFINED OBJECT_BYTES_${OBJECT_ID})
+            list(APPEND OBJECTS ${OBJECT_ID})
+            set(OBJECT_NAME_${OBJECT_ID} "${OBJECT_NAME}")
+            set(OBJECT_BYTES_${OBJECT_ID} 0)
+        endif()
+        math(EXPR OBJECT_BYTES_${OBJECT_ID} "${OBJECT_BYTES_${OBJECT_ID}} + ${BYTES}")
+
+        # Symbol
+        string(REGEX REPLACE "^\\.(text|rodata|data|bss|ramfunc)\\.?" "" SYMBOL "${SECTION_NAME}")
+        if (SYMBOL STREQUAL "")
+            set(SYMBOL "${SECTION_NAME} (${OBJECT_NAME})")
+        endif()
+        pad_number(${BYTES} PADDED)
+        list(APPEND SYMBOLS "${PADDED} ${SYMBOL}")
+
+        # Module
+        set(OWNER Kernel)
+        foreach (MODULE ${MODULES})
+            if (OBJECT MATCHES "Dependencies/${MODULE}/" OR SYMBOL MATCHES "${MODULE_PATTERN_${MODULE}}")
+                set(OWNER ${MODULE})
+                break()
+            endif()
+        endforeach()
+        if (IN_FLASH)
+            math(EXPR MODULE_FLASH_${OWNER} "${MODULE_FLASH_${OWNER}} + ${BYTES}")
+        endif()
+        if (IN_RAM)
+            math(EXPR MODULE_RAM_${OWNER} "${MODULE_RAM_${OWNER}} + ${BYTES}")
+        endif()
+    endif()
+endmacro()
+
+if (MAP AND EXISTS ${MAP})
+    file(STRINGS ${MAP} MAP_LINES)
+    set(IN_MEMORY_MAP OFF)
+    set(OUTPUT_SECTION "")
+    set(PENDING_SECTION "")
+    foreach (LINE IN LISTS MAP_LINES)
+        if (NOT IN_MEMORY_MAP)
+            if (LINE MATCHES "^Linker script and memory map")
+                set(IN_MEMORY_MAP ON)
+            endif()
+            continue()
+        endif()
+
+        if (LINE MATCHES "^(\\.[^ ]+)")
+            # Output section, e.g. `.text           0x00000000     0x1234`
+            set(OUTPUT_SECTION ${CMAKE_MATCH_1})
+            set(PENDING_SECTION "")
+        elseif (NOT OUTPUT_SECTION IN_LIST FLASH_SECTIONS AND
+                NOT OUTPUT_SECTION IN_LIST SHARED_SECTIONS AND
+                NOT OUTPUT_SECTION IN_LIST RAM_SECTIONS)
+            continue()
+        elseif (LINE MATCHES "^ (\\.[^ ]+) +0x[0-9a-fA-F]+ +(0x[0-9a-fA-F]+) +(.+)$")
+            # Input section on a single line, e.g. ` .text.foo      0x00000100       0x24 Main.cpp.obj`
+            account_input_section(${CMAKE_MATCH_1} ${CMAKE_MATCH_2} "${CMAKE_MATCH_3}")
+        elseif (LINE MATCHES "^ (\\.[^ ]+)$")
+            # Input section whose name is too long and whose address and size are on the next line
+            set(PENDING_SECTION ${CMAKE_MATCH_1})
+        elseif (NOT PENDING_SECTION STREQUAL "" AND LINE MATCHES "^ +0x[0-9a-fA-F]+ +(0x[0-9a-fA-F]+) +(.+)$")
+            account_input_section(${PENDING_SECTION} ${CMAKE_MATCH_1} "${CMAKE_MATCH_2}")
+            set(PENDING_SECTION "")
+        endif()
+    endforeach()
+else()
+    message(WARNING "Cannot find the linker map file. Will only report the usage by section.")
+endif()
+
+#
+# MARK: Print the report
+#
+
+if (BASELINE AND EXISTS ${BASELINE})
+    include(${BASELINE})
+endif()
+
+message(STATUS "================================ Size Report ================================")
+print_usage("Flash" ${FLASH_USAGE} "${BASELINE_FLASH}")
+print_usage("SRAM " ${RAM_USAGE} "${BASELINE_RAM}")
+
+message(STATUS "Sections:")
+foreach (NAME ${SECTIONS})
+    string(MAKE_C_IDENTIFIER "${NAME}" ID)
+    print_usage(${NAME} ${SECTION_${NAME}} "${BASELINE_SECTION_${ID}}")
+endforeach()
+
+if (OBJECTS)
+    message(STATUS "Modules (Flash / SRAM):")
+    foreach (MODULE ${MODULES} Kernel)
+        message(STATUS "    ${MODULE}: ${MODULE_FLASH_${MODULE}} / ${MODULE_RAM_${MODULE}} bytes")
+    endforeach()
+
+    message(STATUS "Objects:")
+    foreach (OBJECT_ID ${OBJECTS})
+        message(STATUS "    ${OBJECT_NAME_${OBJECT_ID}}: ${OBJECT_BYTES_${OBJECT_ID}} bytes")
+    endforeach()
+
+    message(STATUS "Top ${TOP_SYMBOLS} symbols:")
+    list(SORT SYMBOLS)
+    list(REVERSE SYMBOLS)
+    list(LENGTH SYMBOLS COUNT)
+    if (COUNT GREATER TOP_SYMBOLS)
+        list(SUBLIST SYMBOLS 0 ${TOP_SYMBOLS} SYMBOLS)
+    endif()
+    foreach (ENTRY ${SYMBOLS})
+        string(REGEX MATCH "^0*([0-9]+) (.+)$" UNUSED "${ENTRY}")
+        set(SYMBOL "${CMAKE_MATCH_2}")
+        set(BYTES "${CMAKE_MATCH_1}")
+        if (CXXFILT)
+            execute_process(COMMAND ${CXXFILT} "${SYMBOL}" OUTPUT_VARIABLE SYMBOL OUTPUT_STRIP_TRAILING_WHITESPACE)
+        endif()
+        message(STATUS "    ${BYTES}\t${SYMBOL}")
+    endforeach()
+endif()
+message(STATUS "=============================================================================")
+
+#
+# MARK: Update the baseline or enforce the budget
+#
+
+if (UPDATE_BASELINE)
+    set(CONTENT "# Generated by SizeReport.cmake. Do not edit.\n")
+    string(APPEND CONTENT "set(BASELINE_FLASH ${FLASH_USAGE})\n")
+    string(APPEND CONTENT "set(BASELINE_RAM ${RAM_USAGE})\n")
+    foreach (NAME ${SECTIONS})
+        string(MAKE_C_IDENTIFIER "${NAME}" ID)
+        string(APPEND CONTENT "set(BASELINE_SECTION_${ID} ${SECTION_${NAME}})\n")
+    endforeach()
+    file(WRITE ${BASELINE} "${CONTENT}")
+    message(STATUS "The size baseline has been saved to ${BASELINE}.")
+    return()
+endif()
+
+set(VIOLATIONS)
+if (FLASH_BUDGET AND FLASH_USAGE GREATER FLASH_BUDGET)
+    list(APPEND VIOLATIONS "Flash: ${FLASH_USAGE} > ${FLASH_BUDGET} bytes")
+endif()
+if (RAM_BUDGET AND RAM_USAGE GREATER RAM_BUDGET)
+    list(APPEND VIOLATIONS "SRAM: ${RAM_USAGE} > ${RAM_BUDGET} bytes")
+endif()
+
+# Per-section budgets are passed as a comma separated list, e.g. `.ramfunc=1024,.bss=2048`
+string(REPLACE "," ";" SECTION_BUDGETS "${SECTION_BUDGETS}")
+foreach (ENTRY ${SECTION_BUDGETS})
+    if (ENTRY MATCHES "^(\\.[^=]+)=([0-9]+)$")
+        set(NAME ${CMAKE_MATCH_1})
+        set(LIMIT ${CMAKE_MATCH_2})
+        if (DEFINED SECTION_${NAME} AND SECTION_${NAME} GREATER LIMIT)
+            list(APPEND VIOLATIONS "${NAME}: ${SECTION_${NAME}} > ${LIMIT} bytes")
+        endif()
+    endif()
+endforeach()
+
+if (VIOLATIONS)
+    foreach (VIOLATION ${VIOLATIONS})
+        message(STATUS "Budget exceeded: ${VIOLATION}")
+    endforeach()
+    message(FATAL_ERROR "The kernel does not fit in the size budget.")
+endif()
@@ -35,6 +35,23 @@ set(CMAKE_CXX_FLAGS_RELEASE         "${CMAKE_CXX_FLAGS_RELEASE} -Os")
 
 set(CMAKE_ASM_FLAGS "${CMAKE_ASM_FLAGS} -x assembler-with-cpp")
 
+#
+# Set the compiler flags for the speed-optimized build profile (i.e. `CMAKE_BUILD_TYPE=ReleaseSpeed`)
+#
+# @note Everything is compiled and link-time optimized at `-O2`,
+#       except the one-shot initialization functions that are marked `cold` and thus still optimized for size.
+# @note The optimization level is also passed to the linker, because GCC applies the link-time level to the LTO code generation,
+#       so a per-file `-O2` override would be lost when the objects are linked with `-Os -flto`.
+# @note `-flto` enables link time optimizations across the kernel and all Tinkertoy modules,
+#       which are compiled with the same flags.
+# @note `-ffat-lto-objects` keeps regular object code in Tinkertoy static libraries,
+#       so that they can be indexed by the archiver that does not support the LTO plugin.
+#
+set(CMAKE_C_FLAGS_RELEASESPEED      "${CMAKE_C_FLAGS_RELEASESPEED} -O2 -flto -ffat-lto-objects")
+set(CMAKE_CXX_FLAGS_RELEASESPEED    "${CMAKE_CXX_FLAGS_RELEASESPEED} -O2 -flto -ffat-lto-objects")
+set(CMAKE_ASM_FLAGS_RELEASESPEED    "${CMAKE_ASM_FLAGS_RELEASESPEED}")
+set(CMAKE_EXE_LINKER_FLAGS_RELEASESPEED "${CMAKE_EXE_LINKER_FLAGS_RELEASESPEED} -O2 -flto")
+
 message(STATUS "C Compiler Flags: ${CMAKE_C_FLAGS}")
 message(STATUS "C Compiler Flags (DEBUG): ${CMAKE_C_FLAGS_DEBUG}")
 message(STATUS "C Compiler Flags (RELEASE): ${CMAKE_C_FLAGS_RELEASE}")
@@ -42,6 +59,7 @@ message(STATUS "C Compiler Flags (RELEASE): ${CMAKE_C_FLAGS_RELEASE}")
 message(STATUS "C++ Compiler Flags: ${CMAKE_CXX_FLAGS}")
 message(STATUS "C++ Compiler Flags (DEBUG): ${CMAKE_CXX_FLAGS_DEBUG}")
 message(STATUS "C++ Compiler Flags (RELEASE): ${CMAKE_CXX_FLAGS_RELEASE}")
+message(STATUS "C++ Compiler Flags (RELEASESPEED): ${CMAKE_CXX_FLAGS_RELEASESPEED}")
 
 #
 # Set the linker flags
@@ -53,8 +71,9 @@ message(STATUS "C++ Compiler Flags (RELEASE): ${CMAKE_CXX_FLAGS_RELEASE}")
 #       The kernel startup routine serves the same purpose.
 # @note `-lgcc` tells the linker to use GCC's internal library that is excluded by the `-nostdlib` option.
 # @note `-Wl,--gc-sections` tells the linker to recycle all unused sections.
+# @note `-Wl,-Map` tells the linker to generate a map file, which is used by the `size-report` target.
 #
-set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} -T ${CMAKE_SOURCE_DIR}/${LINKER_SCRIPT} -nostdlib -lgcc -Wl,--gc-sections")
+set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} -T ${CMAKE_SOURCE_DIR}/${LINKER_SCRIPT} -nostdlib -lgcc -Wl,--gc-sections -Wl,-Map=${CMAKE_BINARY_DIR}/${TARGET}.map")
 
 #
 # Add additional definitions
@@ -193,3 +212,52 @@ else()
     add_custom_command(TARGET ${TARGET} POST_BUILD
             COMMAND ${SIZE} ${CMAKE_BINARY_DIR}/${TARGET})
 endif()
+
+#
+# MARK: Report the flash and SRAM usage and enforce the size budget
+#
+# @note The `size-report` target runs as part of the regular build and fails if any budget is exceeded.
+# @note Run the `size-baseline` target to save the current usage as the baseline for later reports.
+# @note Sections that are loaded from the flash and run in SRAM (i.e. `.data` and `.ramfunc`) count towards both budgets.
+# @note The SRAM usage includes the kernel stack, the reserved part of the heap and the user memory (See `Kernel.ld`).
+# @note The baseline is kept in the build directory, so that saving it never modifies the source tree.
+#
+# @note The last 8 KB of the flash are reserved for the data log (See `Kernel.ld`), so the kernel image gets the first 56 KB.
+#
+set(KERNEL_FLASH_BUDGET 57344 CACHE STRING "Maximum number of bytes of the flash used by the kernel image")
+set(KERNEL_RAM_BUDGET 8192 CACHE STRING "Maximum number of bytes of SRAM used by the kernel, including the stacks and the heap")
+set(KERNEL_SECTION_BUDGETS "" CACHE STRING "Comma separated per-section budgets, e.g. .ramfunc=1024,.bss=2048")
+set(KERNEL_SIZE_BASELINE ${CMAKE_BINARY_DIR}/SizeBaseline.cmake CACHE FILEPATH "Path to the size baseline")
+
+find_program(CXXFILT "arm-none-eabi-c++filt")
+if (SIZE)
+    set(SIZE_REPORT_COMMAND ${CMAKE_COMMAND}
+            -DSIZE=${SIZE}
+            -DCXXFILT=${CXXFILT}
+            -DKERNEL=${CMAKE_BINARY_DIR}/${TARGET}
+            -DMAP=${CMAKE_BINARY_DIR}/${TARGET}.map
+            -DBASELINE=${KERNEL_SIZE_BASELINE}
+            -DFLASH_BUDGET=${KERNEL_FLASH_BUDGET}
+            -DRAM_BUDGET=${KERNEL_RAM_BUDGET}
+            -DSECTION_BUDGETS=${KERNEL_SECTION_BUDGETS})
+
+    add_custom_target(size-report ALL
+            COMMAND ${SIZE_REPORT_COMMAND} -P ${CMAKE_SOURCE_DIR}/.cmake/SizeReport.cmake
+            DEPENDS ${TARGET}
+            COMMENT "Reporting the size of the kernel")
+
+    add_custom_target(size-baseline
+            COMMAND ${SIZE_REPORT_COMMAND} -DUPDATE_BASELINE=ON -P ${CMAKE_SOURCE_DIR}/.cmake/SizeReport.cmake
+            DEPENDS ${TARGET}
+            COMMENT "Saving the size of the kernel as the baseline")
+endif()
+
+#
+# MARK: Print the cost of hot kernel functions relocated to SRAM
+#
+
+find_program(NM "arm-none-eabi-nm")
+if (SIZE)
+    add_custom_command(TARGET ${TARGET} POST_BUILD
+            COMMAND ${CMAKE_COMMAND} -DSIZE=${SIZE} -DNM=${NM} -DKERNEL=${CMAKE_BINARY_DIR}/${TARGET} -P ${CMAKE_SOURCE_DIR}/.cmake/RamFunctionReport.cmake)
+endif()
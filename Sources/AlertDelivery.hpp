@@ -0,0 +1,223 @@
+//
+//  AlertDelivery.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef AlertDelivery_hpp
+#define AlertDelivery_hpp
+
+#include <Types.hpp>
+#include <Debug.hpp>
+#include "UART/WireLink.hpp"
+
+///
+/// Delivers alerts to the actuator reliably
+///
+/// Each alert is sent in its own frame, whose sequence number identifies the alert.
+/// The alert stays in the acknowledgement table until the peer replies with a reading of type `kAckAlert`
+/// (or `kAckSoilWet` for a soil wet alert) whose value is the sequence number of the alert.
+/// Otherwise, the alert is retransmitted with exponential backoff until it runs out of attempts.
+///
+/// The timer interrupt only marks alerts whose timeout has expired,
+/// while the dispatcher retransmits them or gives them up later, since sending a frame takes a while.
+///
+/// @tparam Capacity The maximum number of alerts in flight
+/// @note `tick()` must be called from the timer interrupt every millisecond.
+///
+template <size_t Capacity>
+class AlertDelivery
+{
+public:
+    /// Acknowledges an alert of any type (See `acknowledge()`)
+    static constexpr UInt16 kAnyType = 0xFFFF;
+
+    /// Number of ticks to wait before the first retransmission
+    static constexpr UInt32 kInitialTimeout = 100;
+
+    /// Maximum number of ticks to wait between two retransmissions
+    static constexpr UInt32 kMaxTimeout = 1600;
+
+    /// Maximum number of transmissions of an alert
+    static constexpr UInt32 kMaxAttempts = 6;
+
+private:
+    struct Entry
+    {
+        /// `true` if the alert is waiting for an acknowledgement
+        bool active;
+
+        /// `true` if the timeout has expired and the alert is waiting to be retransmitted or given up
+        bool due;
+
+        /// Number of transmissions so far
+        UInt8 attempts;
+
+        /// Sequence number of the alert frame
+        UInt16 sequence;
+
+        /// Number of ticks to wait before the next retransmission
+        UInt32 remaining;
+
+        /// Number of ticks to wait after the next retransmission
+        UInt32 timeout;
+
+        /// The alert
+        WireProtocol::Reading alert;
+    };
+
+    /// The link used to send alerts
+    WireLink& link;
+
+    /// The acknowledgement table
+    Entry entries[Capacity] = {};
+
+    void transmit(const Entry& entry)
+    {
+        WireProtocol::Frame frame = {};
+
+        frame.sequence = entry.sequence;
+
+        frame.append(entry.alert.type, entry.alert.sensor, entry.alert.value);
+
+        this->link.transmit(frame);
+    }
+
+public:
+    ///
+    /// Create the delivery service on the given link
+    ///
+    /// @param link The link used to send alerts
+    ///
+    explicit AlertDelivery(WireLink& link) : link(link) {}
+
+    ///
+    /// Post an alert
+    ///
+    /// @param type Type of the alert
+    /// @param value Value of the alert
+    /// @return The sequence number of the alert on success, `-1` if there are too many alerts in flight.
+    ///
+    int post(UInt8 type, UInt32 value)
+    {
+        for (Entry& entry : this->entries)
+        {
+            if (entry.active)
+            {
+                continue;
+            }
+
+            WireProtocol::Frame frame = {};
+
+            frame.append(type, 0, value);
+
+            entry.sequence = this->link.send(frame);
+
+            entry.alert = frame.readings[0];
+
+            entry.attempts = 1;
+
+            entry.remaining = kInitialTimeout;
+
+            entry.timeout = kInitialTimeout * 2;
+
+            entry.due = false;
+
+            entry.active = true;
+
+            return entry.sequence;
+        }
+
+        return -1;
+    }
+
+    ///
+    /// Acknowledge the alert with the given sequence number
+    ///
+    /// @param sequence Sequence number of the alert, as received from the peer
+    /// @param type Type of the alert, `kAnyType` to acknowledge an alert of any type
+    /// @return `true` if the alert was in flight, `false` if it is unknown, of another type or has already been acknowledged.
+    /// @note Sequence numbers of frames are 16-bit, so a larger value never matches an alert.
+    ///
+    bool acknowledge(UInt32 sequence, UInt16 type = kAnyType)
+    {
+        if (sequence > 0xFFFF)
+        {
+            return false;
+        }
+
+        for (Entry& entry : this->entries)
+        {
+            if (entry.active && entry.sequence == sequence && (type == kAnyType || entry.alert.type == type))
+            {
+                entry.active = false;
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    ///
+    /// Mark alerts that have not been acknowledged in time
+    ///
+    /// @note This function must be called every millisecond.
+    ///
+    void tick()
+    {
+        for (Entry& entry : this->entries)
+        {
+            if (!entry.active || entry.due)
+            {
+                continue;
+            }
+
+            entry.remaining -= 1;
+
+            entry.due = entry.remaining == 0;
+        }
+    }
+
+    ///
+    /// Retransmit alerts whose timeout has expired, or give them up once they run out of attempts
+    ///
+    /// @param onDropped Invoked with the alert and its sequence number when it is given up
+    /// @note This function sends frames with polled I/O, so it should be called outside the timer interrupt.
+    ///
+    template <typename Handler>
+    void retransmit(Handler onDropped)
+    {
+        for (Entry& entry : this->entries)
+        {
+            if (!entry.active || !entry.due)
+            {
+                continue;
+            }
+
+            entry.due = false;
+
+            if (entry.attempts >= kMaxAttempts)
+            {
+                pinfo("Alert #%d has not been acknowledged after %d attempts. Will give up.", entry.sequence, entry.attempts);
+
+                entry.active = false;
+
+                onDropped(entry.alert, entry.sequence);
+
+                continue;
+            }
+
+            this->transmit(entry);
+
+            entry.attempts += 1;
+
+            entry.remaining = entry.timeout;
+
+            entry.timeout = entry.timeout * 2 > kMaxTimeout ? kMaxTimeout : entry.timeout * 2;
+        }
+    }
+};
+
+#endif /* AlertDelivery_hpp */
@@ -0,0 +1,211 @@
+//
+//  BootTrace.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef BootTrace_hpp
+#define BootTrace_hpp
+
+#include <Types.hpp>
+#include <Debug.hpp>
+#include "CycleCounter.hpp"
+
+///
+/// Records a cycle timestamp at each boot stage from reset to the first dispatched event
+///
+/// @note Timestamps are kept in a fixed array in RAM and printed once the dispatcher goes idle,
+///       so the polled console output does not distort the measurement of later stages.
+///
+namespace BootTrace
+{
+    enum Stage : UInt32
+    {
+        /// The bootloader starts the cycle counter (always zero)
+        kReset = 0,
+
+        /// The bootloader has loaded DATA and cleared BSS
+        kMemoryInitialized,
+
+        /// The kernel main routine starts
+        kKernelMain,
+
+        /// The kernel memory allocator is ready
+        kMemoryManager,
+
+        /// The kernel interrupt vector table is ready
+        kInterruptTable,
+
+        /// The system timer is ready (skipped when running stack experiments)
+        kTimer,
+
+        /// The watchdog timer is running (skipped when running stack experiments)
+        kWatchdog,
+
+        /// UART1 and its RX interrupt are ready
+        kUART1,
+
+        /// The shared user stack is ready
+        kUserStack,
+
+        /// The memory protection unit guards the kernel and the user stack
+        kMemoryProtection,
+
+        /// All event handlers are registered
+        kEvents,
+
+        /// The data log is recovered from the flash
+        kDataLog,
+
+        /// The execution context of the idle handler is ready
+        kIdleContext,
+
+        /// The dispatcher switches to the first event handler
+        kFirstDispatch,
+
+        /// The number of stages
+        kNumStages
+    };
+
+    static inline const char* Stage2String(Stage stage)
+    {
+        switch (stage)
+        {
+            case kReset:
+                return "Reset";
+
+            case kMemoryInitialized:
+                return "DATA/BSS Init";
+
+            case kKernelMain:
+                return "Kernel Main";
+
+            case kMemoryManager:
+                return "Memory Manager";
+
+            case kInterruptTable:
+                return "Interrupt Table";
+
+            case kTimer:
+                return "System Timer";
+
+            case kWatchdog:
+                return "Watchdog";
+
+            case kUART1:
+                return "UART1";
+
+            case kUserStack:
+                return "User Stack";
+
+            case kMemoryProtection:
+                return "Memory Protection";
+
+            case kEvents:
+                return "Event Handlers";
+
+            case kDataLog:
+                return "Data Log";
+
+            case kIdleContext:
+                return "Idle Context";
+
+            case kFirstDispatch:
+                return "First Dispatch";
+
+            default:
+                return "Unknown";
+        }
+    }
+
+    /// Timestamp of each stage in cycles since reset
+    inline UInt32 gTimestamps[kNumStages];
+
+    /// `true` if the trace has been printed
+    inline bool gReported;
+
+    ///
+    /// Record the timestamp of the given stage
+    ///
+    /// @param stage The stage that has just completed
+    ///
+    static inline void record(Stage stage)
+    {
+        gTimestamps[stage] = CycleCounter::read();
+    }
+
+    ///
+    /// Record the first dispatch
+    ///
+    /// @note This function must be called each time the dispatcher switches to an event handler,
+    ///       and only records the first switch, whether it runs a user handler or the idle handler.
+    ///
+    static inline void onDispatch()
+    {
+        if (gTimestamps[kFirstDispatch] == 0)
+        {
+            record(kFirstDispatch);
+        }
+    }
+
+    ///
+    /// Print the breakdown of all recorded stages
+    ///
+    /// @note Stages that have not been recorded are reported as skipped.
+    ///
+    static inline void report()
+    {
+        static constexpr UInt32 kCyclesPerMicrosecond = SYSTEM_CLOCK / 1000000;
+
+        kprintf("========================= Boot Trace =========================\n");
+
+        kprintf("%-16s %12s %12s %12s\n", "Stage", "Cycles", "Delta", "Delta (us)");
+
+        UInt32 previous = gTimestamps[kReset];
+
+        for (UInt32 index = kReset; index < kNumStages; index += 1)
+        {
+            auto stage = static_cast<Stage>(index);
+
+            UInt32 timestamp = gTimestamps[stage];
+
+            if (stage != kReset && timestamp == 0)
+            {
+                kprintf("%-16s %12s\n", Stage2String(stage), "skipped");
+
+                continue;
+            }
+
+            UInt32 delta = timestamp - previous;
+
+            kprintf("%-16s %12u %12u %12u\n", Stage2String(stage), timestamp, delta, delta / kCyclesPerMicrosecond);
+
+            previous = timestamp;
+        }
+
+        kprintf("Reset to first dispatch: %u cycles (%u us).\n",
+                gTimestamps[kFirstDispatch], gTimestamps[kFirstDispatch] / kCyclesPerMicrosecond);
+
+        kprintf("==============================================================\n");
+    }
+
+    ///
+    /// Print the trace
+    ///
+    /// @note This function is a no-op once the trace has been printed.
+    ///
+    static inline void finish()
+    {
+        if (gReported)
+        {
+            return;
+        }
+
+        report();
+
+        gReported = true;
+    }
+}
+
+#endif /* BootTrace_hpp */
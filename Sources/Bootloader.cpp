@@ -6,6 +6,8 @@
 //
 
 #include <Debug.hpp>
+#include "CycleCounter.hpp"
+#include "BootTrace.hpp"
 
 //
 // MARK: - ARM Cortex-M3 Bootloader
@@ -17,14 +19,108 @@ extern "C" void _init(void);
 // C++ kernel main routine provided by the assembled kernel
 extern "C" void kmain(void);
 
+// Entry point of all fault exceptions provided by the assembled kernel
+// Faults in the bootloader are captured as well (See `FaultHandler.hpp`)
+extern "C" void FaultEntryPoint(void);
+
+// Boundaries of the DATA and BSS sections
+// These symbols are provided and set by the linker script
+extern UInt32 __data_load_start, __data_start, __data_end;
+extern UInt32 __bss_start, __bss_end;
+
+// Boundaries of the section that contains hot kernel functions
+// These symbols are provided and set by the linker script
+extern UInt32 __ramfunc_load_start, __ramfunc_start, __ramfunc_end;
+
+// Copy words from the given source to the destination until the destination reaches the given end
+// The loop moves four words per iteration with a single `ldm`/`stm` pair
+// and falls back to a single word per iteration for the remaining tail.
+// Must not rely on any DATA or BSS variables, since neither has been initialized yet.
+__attribute__((section(".bootloader.memcpy")))
+static void BootloaderCopyWords(UInt32* destination, const UInt32* source, const UInt32* end)
+{
+    asm volatile("1: \n"
+                 "sub r3, %[end], %[destination] \n"
+                 "cmp r3, #16 \n"
+                 "blo 2f \n"
+                 "ldmia %[source]!, {r4, r5, r6, r12} \n"
+                 "stmia %[destination]!, {r4, r5, r6, r12} \n"
+                 "b 1b \n"
+                 "2: \n"
+                 "cmp %[destination], %[end] \n"
+                 "bhs 3f \n"
+                 "ldr r4, [%[source]], #4 \n"
+                 "str r4, [%[destination]], #4 \n"
+                 "b 2b \n"
+                 "3: \n"
+                 : [destination] "+r" (destination), [source] "+r" (source)
+                 : [end] "r" (end)
+                 : "r3", "r4", "r5", "r6", "r12", "cc", "memory"
+                 );
+}
+
+// Zero words from the given start until it reaches the given end
+// Same as above, but stores four zero registers per iteration.
+__attribute__((section(".bootloader.memset")))
+static void BootloaderZeroWords(UInt32* start, const UInt32* end)
+{
+    asm volatile("mov r4, #0 \n"
+                 "mov r5, #0 \n"
+                 "mov r6, #0 \n"
+                 "mov r12, #0 \n"
+                 "1: \n"
+                 "sub r3, %[end], %[start] \n"
+                 "cmp r3, #16 \n"
+                 "blo 2f \n"
+                 "stmia %[start]!, {r4, r5, r6, r12} \n"
+                 "b 1b \n"
+                 "2: \n"
+                 "cmp %[start], %[end] \n"
+                 "bhs 3f \n"
+                 "str r4, [%[start]], #4 \n"
+                 "b 2b \n"
+                 "3: \n"
+                 : [start] "+r" (start)
+                 : [end] "r" (end)
+                 : "r3", "r4", "r5", "r6", "r12", "cc", "memory"
+                 );
+}
+
+// Load the DATA section and hot kernel functions from their load addresses in the flash and clear the BSS section
+// The linker script guarantees that all boundaries are aligned at the 4-byte boundary.
+__attribute__((section(".bootloader.meminit")))
+static void BootloaderInitMemory()
+{
+    BootloaderCopyWords(&__data_start, &__data_load_start, &__data_end);
+
+    BootloaderCopyWords(&__ramfunc_start, &__ramfunc_load_start, &__ramfunc_end);
+
+    BootloaderZeroWords(&__bss_start, &__bss_end);
+}
+
 // Entry point of the bootloader
 extern "C"
 __attribute__((section(".bootloader.start")))
 void start()
 {
     // On reset, the bootloader runs in the thread mode
+    // Start the cycle counter so that we can measure the cost of each boot stage
+    CycleCounter::enable();
+
+    // Initialize DATA and BSS sections before running any C/C++ code that may rely on them
+    // Note that the boot trace lives in BSS, so the first timestamp can only be recorded afterwards
+    BootloaderInitMemory();
+
+    BootTrace::record(BootTrace::kMemoryInitialized);
+
     pinfo("Bootloader started.");
 
+    pinfo("Loaded %d bytes of DATA, %d bytes of RAM functions and cleared %d bytes of BSS in %d cycles.",
+          (&__data_end - &__data_start) * sizeof(UInt32),
+          (&__ramfunc_end - &__ramfunc_start) * sizeof(UInt32),
+          (&__bss_end - &__bss_start) * sizeof(UInt32),
+          BootTrace::gTimestamps[BootTrace::kMemoryInitialized]);
+
     // Trigger a system call to bring the processor to the handler mode
     asm("svc 0");
 
@@ -82,16 +178,16 @@ volatile void* gBootloaderVectorTable[] =
     nullptr,
 
     // Hard Fault Handler
-    nullptr,
+    reinterpret_cast<void*>(FaultEntryPoint),
 
     // Memory Management Handler
-    nullptr,
+    reinterpret_cast<void*>(FaultEntryPoint),
 
     // Bus Fault Handler
-    nullptr,
+    reinterpret_cast<void*>(FaultEntryPoint),
 
     // Usage Fault Handler
-    nullptr,
+    reinterpret_cast<void*>(FaultEntryPoint),
 
     // Reserved
     nullptr,
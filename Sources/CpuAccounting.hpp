@@ -0,0 +1,151 @@
+//
+//  CpuAccounting.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef CpuAccounting_hpp
+#define CpuAccounting_hpp
+
+#include <Types.hpp>
+#include <Debug.hpp>
+#include "CycleCounter.hpp"
+
+///
+/// A component that accumulates the number of cycles a task runs in thread mode
+///
+struct CpuTimeSupport
+{
+    /// Number of cycles spent in the task since the last report
+    UInt32 cycles = 0;
+};
+
+///
+/// Accounts the processor time to event handlers (including the idle handler), system calls and interrupts
+///
+/// The dispatcher samples the cycle counter at each task switch boundary:
+/// The time between leaving and entering the kernel is charged to the event handler that was running,
+/// and the time between entering and leaving the kernel is charged to system calls or interrupts depending on the cause.
+/// Native interrupt handlers run without entering the kernel, so their time is charged to interrupts
+/// and taken off the event handler they interrupt.
+///
+/// @note QEMU does not emulate the cycle counter, so the numbers are only meaningful in ARM FastModel or on real hardware.
+/// @note The kernel prints the report only if it is built with `KERNEL_RUNTIME_REPORTS`.
+///
+namespace CpuAccounting
+{
+    /// Timestamp of the last task switch boundary
+    inline UInt32 gTimestamp;
+
+    /// `true` if the kernel was entered by an interrupt rather than a system call
+    inline bool gInterrupt;
+
+    /// Number of cycles spent in the kernel serving system calls since the last report
+    inline UInt32 gSyscallCycles;
+
+    /// Number of cycles spent in the kernel serving interrupts since the last report
+    inline UInt32 gInterruptCycles;
+
+    ///
+    /// Invoked when the kernel is about to switch to a task
+    ///
+    static inline void onKernelExit()
+    {
+        UInt32 now = CycleCounter::read();
+
+        (gInterrupt ? gInterruptCycles : gSyscallCycles) += now - gTimestamp;
+
+        gTimestamp = now;
+    }
+
+    ///
+    /// Invoked when the kernel is entered from the given task
+    ///
+    /// @param task The task that was running
+    /// @param interrupt `true` if the kernel is entered by an interrupt, `false` if by a system call
+    ///
+    static inline void onKernelEntry(CpuTimeSupport& task, bool interrupt)
+    {
+        UInt32 now = CycleCounter::read();
+
+        task.cycles += now - gTimestamp;
+
+        gTimestamp = now;
+
+        gInterrupt = interrupt;
+    }
+
+    ///
+    /// Invoked when a native interrupt handler is about to run
+    ///
+    /// @return The timestamp to pass to `onNativeInterruptExit()`.
+    ///
+    static inline UInt32 onNativeInterruptEntry()
+    {
+        return CycleCounter::read();
+    }
+
+    ///
+    /// Invoked when a native interrupt handler has returned
+    ///
+    /// @param start The timestamp returned by `onNativeInterruptEntry()`
+    /// @note The last task switch boundary is moved forward by the time spent in the native handler,
+    ///       so that the time is not charged to the event handler or the kernel it has interrupted.
+    ///
+    static inline void onNativeInterruptExit(UInt32 start)
+    {
+        UInt32 elapsed = CycleCounter::read() - start;
+
+        gInterruptCycles += elapsed;
+
+        gTimestamp += elapsed;
+    }
+
+    ///
+    /// Print the share of the processor time of each event handler, system calls and interrupts, and start a new interval
+    ///
+    /// @param controller The event controller
+    /// @param numEvents The number of events
+    ///
+    template <typename Controller>
+    static inline void report(Controller& controller, size_t numEvents)
+    {
+        UInt64 total = static_cast<UInt64>(gSyscallCycles) + gInterruptCycles;
+
+        for (size_t event = 0; event < numEvents; event += 1)
+        {
+            total += controller.getRegisteredEvent(event)->cycles;
+        }
+
+        if (total == 0)
+        {
+            return;
+        }
+
+        kprintf("========================= CPU Utilization =========================\n");
+
+        kprintf("%-16s %12s %8s\n", "Consumer", "Cycles", "CPU %");
+
+        for (size_t event = 0; event < numEvents; event += 1)
+        {
+            CpuTimeSupport& task = *controller.getRegisteredEvent(event);
+
+            kprintf("%-10s %-5u %12u %8u\n", event == 0 ? "Idle" : "Event", event, task.cycles, static_cast<UInt32>(task.cycles * 100ULL / total));
+
+            task.cycles = 0;
+        }
+
+        kprintf("%-16s %12u %8u\n", "Kernel: Syscall", gSyscallCycles, static_cast<UInt32>(gSyscallCycles * 100ULL / total));
+
+        kprintf("%-16s %12u %8u\n", "Kernel: IRQ", gInterruptCycles, static_cast<UInt32>(gInterruptCycles * 100ULL / total));
+
+        kprintf("===================================================================\n");
+
+        gSyscallCycles = 0;
+
+        gInterruptCycles = 0;
+    }
+}
+
+#endif /* CpuAccounting_hpp */
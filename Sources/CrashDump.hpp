@@ -0,0 +1,158 @@
+//
+//  CrashDump.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef CrashDump_hpp
+#define CrashDump_hpp
+
+#include <Types.hpp>
+#include <cstddef>
+
+///
+/// Diagnostics captured by the fault handler and kept in retained RAM across the reset that follows
+///
+/// @note The dump lives in the `.retained` section, which the bootloader neither loads nor clears.
+///       It is valid only if both the magic and the checksum match, since the SRAM holds garbage after a power cycle.
+///
+struct CrashDump
+{
+    static constexpr UInt32 kMagic = 0x48535243; // "CRSH"
+
+    /// The number of dispatched event handlers kept in the history
+    static constexpr size_t kHistoryDepth = 8;
+
+    /// Identifier of an unknown event or of the kernel idle loop
+    static constexpr UInt8 kNoEvent = 0xFF;
+
+    UInt32 magic;
+
+    /// Exception number of the fault (3: Hard Fault, 4: Memory Management, 5: Bus Fault, 6: Usage Fault)
+    UInt32 exception;
+
+    /// Configurable Fault Status Register
+    UInt32 cfsr;
+
+    /// Hard Fault Status Register
+    UInt32 hfsr;
+
+    /// Memory Management Fault Address Register (valid if `CFSR.MMARVALID` is set)
+    UInt32 mmfar;
+
+    /// Bus Fault Address Register (valid if `CFSR.BFARVALID` is set)
+    UInt32 bfar;
+
+    /// EXC_RETURN value of the fault handler, which tells whether the frame was stacked on the process or main stack
+    UInt32 excReturn;
+
+    /// Address of the stacked frame
+    UInt32 stackPointer;
+
+    /// Registers stacked by the processor (R0-R3, R12, LR, PC, xPSR), all zeros if stacking failed
+    UInt32 frame[8];
+
+    /// Kernel uptime in milliseconds
+    UInt32 uptime;
+
+    /// Event handled by the running handler
+    UInt8 event;
+
+    /// Events of the most recently dispatched handlers, oldest first
+    UInt8 history[kHistoryDepth];
+
+    UInt8 reserved[3];
+
+    UInt32 checksum;
+
+    ///
+    /// Compute the checksum of all fields except the checksum itself
+    ///
+    [[nodiscard]]
+    UInt32 computeChecksum() const
+    {
+        const auto* words = reinterpret_cast<const UInt32*>(this);
+
+        UInt32 checksum = 0;
+
+        for (size_t index = 0; index < offsetof(CrashDump, checksum) / sizeof(UInt32); index += 1)
+        {
+            checksum = (checksum << 1 | checksum >> 31) ^ words[index];
+        }
+
+        return checksum;
+    }
+
+    ///
+    /// Check whether the dump has been captured before the last reset
+    ///
+    [[nodiscard]]
+    bool isValid() const
+    {
+        return this->magic == kMagic && this->checksum == this->computeChecksum();
+    }
+
+    ///
+    /// Seal the dump after all fields have been captured
+    ///
+    void seal()
+    {
+        this->magic = kMagic;
+
+        this->checksum = this->computeChecksum();
+    }
+
+    ///
+    /// Invalidate the dump once it has been reported
+    ///
+    void invalidate()
+    {
+        this->magic = 0;
+    }
+};
+
+static_assert(offsetof(CrashDump, checksum) % sizeof(UInt32) == 0, "The checksum must be word aligned.");
+
+/// The crash dump captured before the last reset
+__attribute__((section(".retained.crashdump")))
+inline CrashDump gCrashDump;
+
+///
+/// Records the most recently dispatched event handlers
+///
+/// @tparam Task Type of a task
+/// @tparam Depth The number of handlers to keep
+///
+template <typename Task, size_t Depth>
+class DispatchHistory
+{
+    const Task* tasks[Depth] = {};
+
+    size_t next = 0;
+
+public:
+    ///
+    /// Record the handler that is about to run
+    ///
+    void record(const Task* task)
+    {
+        this->tasks[this->next] = task;
+
+        this->next = (this->next + 1) % Depth;
+    }
+
+    ///
+    /// Visit recorded handlers, oldest first
+    ///
+    template <typename Visitor>
+    void forEach(Visitor visitor) const
+    {
+        for (size_t index = 0; index < Depth; index += 1)
+        {
+            visitor(this->tasks[(this->next + index) % Depth]);
+        }
+    }
+};
+
+#endif /* CrashDump_hpp */
@@ -0,0 +1,46 @@
+//
+//  CycleCounter.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef CycleCounter_hpp
+#define CycleCounter_hpp
+
+#include <Types.hpp>
+#include "CMSIS/ARMCM3.h"
+
+///
+/// A thin wrapper of the DWT cycle counter on ARM Cortex-M3
+///
+/// @note The counter wraps around every 2^32 cycles (~86 seconds at 50 MHz),
+///       so callers should only compute the difference between two nearby samples.
+/// @note QEMU does not emulate the DWT unit, so all samples read as zero in the emulator.
+///
+namespace CycleCounter
+{
+    ///
+    /// Enable and reset the cycle counter
+    ///
+    static inline void enable()
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+        DWT->CYCCNT = 0;
+
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    ///
+    /// Read the current value of the cycle counter
+    ///
+    /// @return The number of cycles elapsed since the counter was enabled.
+    ///
+    static inline UInt32 read()
+    {
+        return DWT->CYCCNT;
+    }
+}
+
+#endif /* CycleCounter_hpp */
@@ -0,0 +1,428 @@
+//
+//  DataLog.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef DataLog_hpp
+#define DataLog_hpp
+
+#include <Types.hpp>
+#include <Debug.hpp>
+#include "Flash/FlashController.hpp"
+#include "UART/WireLink.hpp"
+#include "Message.hpp"
+#include "DataLogRecord.hpp"
+
+///
+/// A log-structured, wear-aware append store of timestamped records in a reserved flash region
+///
+/// Layout:
+/// The region is a circular sequence of 1 KB pages.
+/// Each page starts with a header of two words (i.e. the magic and the sequence number of the page),
+/// followed by 8-byte records programmed in order until the page is full.
+///
+/// | Word | Bits    | Field                                |
+/// |------|---------|--------------------------------------|
+/// | 0    | 0 - 7   | Type of the record (See below)       |
+/// | 0    | 8 - 15  | Sensor identifier                    |
+/// | 0    | 16 - 31 | Value (clamped to 16 bits)           |
+/// | 1    | 0 - 31  | Kernel uptime in milliseconds        |
+///
+/// A logged reading keeps its `Message::Type`, while records of kernel events use the log-only kinds in `RecordType`.
+///
+/// Wear leveling:
+/// Pages are always filled in order, so every page is erased once per pass over the region,
+/// and the oldest page is erased only when the log needs room for new records.
+/// On boot, the page with the highest sequence number is the one being filled.
+///
+/// Write combining:
+/// Records are appended to a buffer in RAM first and programmed in batches,
+/// either when the buffer is full, when the caller flushes the log (e.g. for an alert) or every `kFlushInterval` ticks.
+///
+/// @tparam BufferSize The number of records buffered in RAM
+/// @note `tick()` must be called from the timer interrupt every millisecond.
+/// @note All functions must be called with interrupts disabled (i.e. in the kernel).
+///
+template <size_t BufferSize>
+class DataLog
+{
+public:
+    /// Number of ticks after which buffered records are programmed
+    static constexpr UInt32 kFlushInterval = 60000;
+
+    /// Kinds of records that are not readings
+    using RecordType = DataLogRecord::Type;
+
+    struct Record
+    {
+        UInt32 header;
+
+        UInt32 timestamp;
+
+        static Record make(UInt8 type, UInt8 sensor, UInt32 value, UInt32 timestamp)
+        {
+            UInt32 clamped = value > 0xFFFF ? 0xFFFF : value;
+
+            return {static_cast<UInt32>(type) | static_cast<UInt32>(sensor) << 8 | clamped << 16, timestamp};
+        }
+
+        [[nodiscard]]
+        UInt8 getType() const { return this->header & 0xFF; }
+
+        [[nodiscard]]
+        UInt8 getSensor() const { return (this->header >> 8) & 0xFF; }
+
+        [[nodiscard]]
+        UInt32 getValue() const { return this->header >> 16; }
+    };
+
+private:
+    static constexpr UInt32 kPageMagic = 0x21474F4C; // "LOG!"
+
+    static constexpr UInt32 kPageHeaderSize = 8;
+
+    static constexpr UInt32 kRecordSize = sizeof(Record);
+
+    static_assert(kRecordSize == 8, "A record must occupy two words.");
+
+    /// Start address of the region
+    UInt32 start = 0;
+
+    /// Number of pages in the region
+    UInt32 numPages = 0;
+
+    /// Index of the page being filled
+    UInt32 page = 0;
+
+    /// Sequence number of the page being filled
+    UInt32 sequence = 0;
+
+    /// Address of the next free record slot in the flash
+    UInt32 cursor = 0;
+
+    /// Records waiting to be programmed
+    Record buffer[BufferSize];
+
+    /// Number of records in the buffer
+    size_t count = 0;
+
+    /// Number of ticks until the next periodic flush
+    UInt32 remaining = kFlushInterval;
+
+    /// `true` once the region has been recovered or formatted, so that the log never programs an unprepared address
+    bool valid = false;
+
+    [[nodiscard]]
+    UInt32 getPageAddress(UInt32 index) const
+    {
+        return this->start + index * FlashController::kPageSize;
+    }
+
+    ///
+    /// Erase the given page and make it the page being filled
+    ///
+    bool openPage(UInt32 index, UInt32 sequence)
+    {
+        UInt32 address = this->getPageAddress(index);
+
+        if (!FlashController::erasePage(address) ||
+            !FlashController::programWord(address, kPageMagic) ||
+            !FlashController::programWord(address + 4, sequence))
+        {
+            return false;
+        }
+
+        this->page = index;
+
+        this->sequence = sequence;
+
+        this->cursor = address + kPageHeaderSize;
+
+        return true;
+    }
+
+    ///
+    /// Visit records in the flash in chronological order
+    ///
+    /// @param visitor Returns `false` to stop the visit
+    ///
+    template <typename Visitor>
+    void forEachRecord(Visitor visitor) const
+    {
+        // The page after the one being filled is the oldest one
+        for (UInt32 offset = 1; offset <= this->numPages; offset += 1)
+        {
+            UInt32 address = this->getPageAddress((this->page + offset) % this->numPages);
+
+            if (FlashController::readWord(address) != kPageMagic)
+            {
+                continue;
+            }
+
+            for (UInt32 slot = address + kPageHeaderSize; slot < address + FlashController::kPageSize; slot += kRecordSize)
+            {
+                Record record = {FlashController::readWord(slot), FlashController::readWord(slot + 4)};
+
+                if (record.header == FlashController::kErasedWord)
+                {
+                    break;
+                }
+
+                if (!visitor(record))
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+public:
+    ///
+    /// Recover the log from the given flash region
+    ///
+    /// @param start Start address of the region (page aligned)
+    /// @param end End address of the region (page aligned)
+    /// @return `true` on success, `false` if the flash controller fails to prepare the region.
+    ///
+    bool init(UInt32 start, UInt32 end)
+    {
+        this->valid = false;
+
+        this->start = start;
+
+        this->numPages = (end - start) / FlashController::kPageSize;
+
+        // Find the page with the highest sequence number
+        bool found = false;
+
+        for (UInt32 index = 0; index < this->numPages; index += 1)
+        {
+            UInt32 address = this->getPageAddress(index);
+
+            if (FlashController::readWord(address) != kPageMagic)
+            {
+                continue;
+            }
+
+            UInt32 sequence = FlashController::readWord(address + 4);
+
+            if (!found || sequence > this->sequence)
+            {
+                found = true;
+
+                this->page = index;
+
+                this->sequence = sequence;
+            }
+        }
+
+        if (!found)
+        {
+            pinfo("Data log: No valid page found. Will format the region.");
+
+            this->valid = this->openPage(0, 1);
+
+            return this->valid;
+        }
+
+        // Find the first free slot in the page being filled
+        UInt32 address = this->getPageAddress(this->page);
+
+        this->cursor = address + kPageHeaderSize;
+
+        while (this->cursor < address + FlashController::kPageSize && FlashController::readWord(this->cursor) != FlashController::kErasedWord)
+        {
+            this->cursor += kRecordSize;
+        }
+
+        pinfo("Data log: Resumed at page %d (Sequence = %d, Offset = %d).", this->page, this->sequence, this->cursor - address);
+
+        this->valid = true;
+
+        return true;
+    }
+
+    ///
+    /// Check whether the log has been recovered from or formatted in its flash region
+    ///
+    /// @return `true` if the log is ready, `false` if `init()` has failed or has not been called.
+    /// @note All other functions do nothing if the log is not ready.
+    ///
+    [[nodiscard]]
+    bool isValid() const
+    {
+        return this->valid;
+    }
+
+    ///
+    /// Append a record
+    ///
+    /// @param type Type of the record
+    /// @param sensor Identifier of the sensor
+    /// @param value Value of the record (clamped to 16 bits)
+    /// @param timestamp Kernel uptime in milliseconds
+    /// @note The buffer is flushed automatically once it becomes full.
+    /// @note The record is dropped if the buffer is still full because the flash controller has failed to program it.
+    ///
+    void append(UInt8 type, UInt8 sensor, UInt32 value, UInt32 timestamp)
+    {
+        if (!this->valid || this->count == BufferSize)
+        {
+            return;
+        }
+
+        this->buffer[this->count] = Record::make(type, sensor, value, timestamp);
+
+        this->count += 1;
+
+        if (this->count == BufferSize)
+        {
+            this->flush();
+        }
+    }
+
+    ///
+    /// Remove the given number of records from the front of the buffer
+    ///
+    void discard(size_t programmed)
+    {
+        for (size_t index = programmed; index < this->count; index += 1)
+        {
+            this->buffer[index - programmed] = this->buffer[index];
+        }
+
+        this->count -= programmed;
+    }
+
+    ///
+    /// Program all buffered records to the flash
+    ///
+    /// @return `true` on success, `false` if the flash controller fails.
+    /// @note Records programmed before a failure are removed from the buffer, so that they are never programmed twice,
+    ///       and the remaining ones are retried by the next flush.
+    ///
+    bool flush()
+    {
+        if (!this->valid)
+        {
+            return false;
+        }
+
+        for (size_t index = 0; index < this->count; index += 1)
+        {
+            // Recycle the oldest page if the current one is full
+            if (this->cursor >= this->getPageAddress(this->page) + FlashController::kPageSize &&
+                !this->openPage((this->page + 1) % this->numPages, this->sequence + 1))
+            {
+                this->discard(index);
+
+                return false;
+            }
+
+            bool programmed = FlashController::programWord(this->cursor, this->buffer[index].header) &&
+                              FlashController::programWord(this->cursor + 4, this->buffer[index].timestamp);
+
+            if (!programmed)
+            {
+                // A partially programmed slot is skipped, since a word cannot be programmed twice,
+                // while a slot that is still erased is reused, since readers stop at the first erased slot
+                if (FlashController::readWord(this->cursor) != FlashController::kErasedWord)
+                {
+                    this->cursor += kRecordSize;
+                }
+
+                this->discard(index);
+
+                return false;
+            }
+
+            this->cursor += kRecordSize;
+        }
+
+        this->count = 0;
+
+        return true;
+    }
+
+    ///
+    /// Flush the buffered records periodically
+    ///
+    /// @note This function must be called every millisecond.
+    ///
+    void tick()
+    {
+        this->remaining -= 1;
+
+        if (this->remaining != 0)
+        {
+            return;
+        }
+
+        this->remaining = kFlushInterval;
+
+        if (this->count != 0)
+        {
+            this->flush();
+        }
+    }
+
+    ///
+    /// Stream the next batch of records in chronological order over the given link
+    ///
+    /// @param link The link to a peer device
+    /// @param position Index of the first record to send in chronological order (`0` to start over)
+    /// @return The number of records sent, `0` once all records have been sent.
+    /// @note Each call sends at most one frame, so that interrupts are never disabled for long,
+    ///       and the caller advances the position by the returned count until it returns `0`.
+    /// @note Each record is sent as a reading of type `kTimestamp` followed by the logged reading.
+    /// @note Positions shift if the oldest page is recycled between two calls.
+    ///
+    size_t stream(WireLink& link, UInt32 position)
+    {
+        static_assert(WireProtocol::kMaxReadings % 2 == 0, "A frame must carry whole records.");
+
+        if (!this->valid)
+        {
+            return 0;
+        }
+
+        // Buffered records are programmed once at the start, so that they are streamed as well
+        if (position == 0)
+        {
+            this->flush();
+        }
+
+        WireProtocol::Reading readings[WireProtocol::kMaxReadings];
+
+        size_t length = 0;
+
+        UInt32 index = 0;
+
+        this->forEachRecord([&](const Record& record)
+        {
+            if (index < position)
+            {
+                index += 1;
+
+                return true;
+            }
+
+            readings[length++] = {RecordType::kTimestamp, record.getSensor(), record.timestamp};
+
+            readings[length++] = {record.getType(), record.getSensor(), record.getValue()};
+
+            return length < WireProtocol::kMaxReadings;
+        });
+
+        if (length != 0)
+        {
+            link.send(readings, length);
+        }
+
+        return length / 2;
+    }
+};
+
+#endif /* DataLog_hpp */
@@ -0,0 +1,80 @@
+//
+//  DataLogRecord.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef DataLogRecord_hpp
+#define DataLogRecord_hpp
+
+#include "Types.hpp"
+
+///
+/// Kinds of records that only exist in the data log and in the diagnostics streamed from it
+///
+/// Logged readings keep their `Message::Type`, so these kinds start at `kFirstType` and never collide with a message type.
+///
+struct DataLogRecord
+{
+    enum Type : UInt8
+    {
+        /// The first kind of record that is not a message type
+        kFirstType = 0x80,
+
+        /// Kernel uptime in milliseconds of the logged reading that follows (Only sent when the log is streamed)
+        kTimestamp = kFirstType,
+
+        /// Marks a reboot of the device; the value is 1 if the watchdog timer has reset the device, 0 otherwise
+        kBoot,
+
+        /// An event handler accessed memory it does not own; the sensor is the event and the value is the faulting address
+        kMemoryFault,
+
+        /// A field of the crash dump captured before the last reset; the sensor is the index of the field (See `reportCrashDump()`)
+        kCrashDump,
+
+        /// An event handler has been aborted for exceeding its execution budget; the sensor is the event and the value is the time it ran in milliseconds
+        kBudgetOverrun,
+
+        /// Delivery of an alert has been given up; the sensor is the type of the alert and the value is its sequence number
+        kAlertDropped,
+    };
+
+    ///
+    /// Check whether the given type of a reading is a kind of log record
+    ///
+    static inline bool isLogRecord(UInt8 type)
+    {
+        return type >= kFirstType;
+    }
+
+    static inline const char* Type2String(Type type)
+    {
+        switch (type)
+        {
+            case kTimestamp:
+                return "Timestamp";
+
+            case kBoot:
+                return "Boot";
+
+            case kMemoryFault:
+                return "Memory Fault";
+
+            case kCrashDump:
+                return "Crash Dump";
+
+            case kBudgetOverrun:
+                return "Budget Overrun";
+
+            case kAlertDropped:
+                return "Alert Dropped";
+
+            default:
+                return "Unknown";
+        }
+    }
+};
+
+#endif /* DataLogRecord_hpp */
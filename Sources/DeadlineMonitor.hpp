@@ -0,0 +1,116 @@
+//
+//  DeadlineMonitor.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef DeadlineMonitor_hpp
+#define DeadlineMonitor_hpp
+
+#include <Types.hpp>
+#include <Debug.hpp>
+#include "DeadlineQueue.hpp"
+
+///
+/// Counts the number of deadlines met and missed by each event handler and the number of times it has been aborted
+///
+/// @tparam NumEvents The number of events
+/// @note All functions must be called with interrupts disabled (i.e. in the kernel).
+/// @note The kernel prints the report only if it is built with `KERNEL_RUNTIME_REPORTS`.
+///
+template <size_t NumEvents>
+class DeadlineMonitor
+{
+    struct Statistics
+    {
+        /// Number of completions
+        UInt32 completed;
+
+        /// Number of completions past the deadline
+        UInt32 missed;
+
+        /// Maximum number of milliseconds past the deadline
+        UInt32 maxLateness;
+
+        /// Number of times the handler has been aborted for exceeding its execution budget
+        UInt32 aborted;
+    };
+
+    Statistics statistics[NumEvents] = {};
+
+public:
+    ///
+    /// Invoked when an event handler completes
+    ///
+    /// @param event Identifier of the event
+    /// @param task The control block of the event handler
+    /// @param now Current time in milliseconds
+    ///
+    void onHandlerCompleted(size_t event, const DeadlineSupport& task, UInt32 now)
+    {
+        if (event >= NumEvents || !task.hasDeadline())
+        {
+            return;
+        }
+
+        Statistics& stats = this->statistics[event];
+
+        stats.completed += 1;
+
+        UInt32 lateness = task.getLateness(now);
+
+        if (lateness == 0)
+        {
+            return;
+        }
+
+        stats.missed += 1;
+
+        if (lateness > stats.maxLateness)
+        {
+            stats.maxLateness = lateness;
+        }
+
+        pinfo("Event %d missed its deadline by %d ms.", event, lateness);
+    }
+
+    ///
+    /// Invoked when an event handler is aborted for exceeding its execution budget
+    ///
+    /// @param event Identifier of the event
+    ///
+    void onHandlerAborted(size_t event)
+    {
+        if (event < NumEvents)
+        {
+            this->statistics[event].aborted += 1;
+        }
+    }
+
+    ///
+    /// Print the statistics of all events that have a deadline or have been aborted
+    ///
+    void report() const
+    {
+        kprintf("======================== Deadline Report ==========================\n");
+
+        kprintf("%-8s %10s %10s %16s %10s\n", "Event", "Completed", "Missed", "Max Late (ms)", "Aborted");
+
+        for (size_t event = 0; event < NumEvents; event += 1)
+        {
+            const Statistics& stats = this->statistics[event];
+
+            if (stats.completed == 0 && stats.aborted == 0)
+            {
+                continue;
+            }
+
+            kprintf("%-8u %10u %10u %16u %10u\n", event, stats.completed, stats.missed, stats.maxLateness, stats.aborted);
+        }
+
+        kprintf("===================================================================\n");
+    }
+};
+
+#endif /* DeadlineMonitor_hpp */
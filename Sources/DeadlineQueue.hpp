@@ -0,0 +1,167 @@
+//
+//  DeadlineQueue.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef DeadlineQueue_hpp
+#define DeadlineQueue_hpp
+
+#include <Types.hpp>
+
+///
+/// A component that attaches a deadline to a task
+///
+/// @note Deadlines are absolute times in milliseconds since the kernel started and may wrap around.
+///       They are compared relative to each other, so two deadlines must be less than 2^31 ms apart.
+///
+struct DeadlineSupport
+{
+    /// Indicates that the task has no deadline
+    static constexpr UInt32 kNoDeadline = 0;
+
+    /// Time allowed for the task to complete once it is released (`kNoDeadline` if none)
+    UInt32 relativeDeadline = kNoDeadline;
+
+    /// Time by which the task must complete
+    UInt32 deadline = 0;
+
+    [[nodiscard]]
+    bool hasDeadline() const
+    {
+        return this->relativeDeadline != kNoDeadline;
+    }
+
+    ///
+    /// Release the task at the given time and set its absolute deadline
+    ///
+    /// @param now Current time in milliseconds
+    ///
+    void release(UInt32 now)
+    {
+        this->deadline = now + this->relativeDeadline;
+    }
+
+    ///
+    /// Check whether the task misses its deadline if it completes at the given time
+    ///
+    /// @param now Current time in milliseconds
+    /// @return The number of milliseconds past the deadline, `0` if the task meets its deadline or has no deadline.
+    ///
+    [[nodiscard]]
+    UInt32 getLateness(UInt32 now) const
+    {
+        if (!this->hasDeadline() || static_cast<SInt32>(now - this->deadline) <= 0)
+        {
+            return 0;
+        }
+
+        return now - this->deadline;
+    }
+
+    ///
+    /// Check whether the given task must complete before the other one
+    ///
+    /// @param lhs A task
+    /// @param rhs Another task
+    /// @return `true` if `lhs` has an earlier deadline than `rhs`, `false` otherwise.
+    /// @note A task without deadline never precedes another task.
+    ///
+    static bool precedes(const DeadlineSupport& lhs, const DeadlineSupport& rhs)
+    {
+        if (!lhs.hasDeadline())
+        {
+            return false;
+        }
+
+        if (!rhs.hasDeadline())
+        {
+            return true;
+        }
+
+        return static_cast<SInt32>(lhs.deadline - rhs.deadline) < 0;
+    }
+};
+
+///
+/// A ready queue that orders tasks by their absolute deadlines
+///
+/// Tasks are kept in an array sorted by deadline, with the earliest one at the end,
+/// so that taking the next task is O(1) and inserting one is O(n).
+/// Tasks with the same deadline are served in the order they become ready.
+///
+/// @tparam Task Type of a task that supports deadlines (See `DeadlineSupport`)
+/// @tparam Capacity The maximum number of ready tasks
+/// @note Each task is in the queue at most once, so the capacity is the number of tasks in the system.
+///
+template <typename Task, size_t Capacity>
+class EarliestDeadlineFirstQueue
+{
+    /// Ready tasks sorted by deadline in descending order
+    Task* tasks[Capacity] = {};
+
+    /// Number of ready tasks
+    size_t count = 0;
+
+public:
+    ///
+    /// Check whether the ready queue is empty
+    ///
+    /// @return `true` if no task is ready to run, `false` otherwise.
+    ///
+    [[nodiscard]]
+    bool isReadyQueueEmpty() const
+    {
+        return this->count == 0;
+    }
+
+    ///
+    /// Peek the task with the earliest deadline
+    ///
+    /// @return The non-null task with the earliest deadline.
+    /// @warning The ready queue must not be empty.
+    ///
+    [[nodiscard]]
+    Task* peek() const
+    {
+        return this->tasks[this->count - 1];
+    }
+
+    ///
+    /// Remove the task with the earliest deadline from the ready queue
+    ///
+    /// @return The non-null task with the earliest deadline.
+    /// @warning The ready queue must not be empty.
+    ///
+    Task* next()
+    {
+        this->count -= 1;
+
+        return this->tasks[this->count];
+    }
+
+    ///
+    /// Add the given task to the ready queue
+    ///
+    /// @param task A non-null task that is not in the ready queue
+    ///
+    void ready(Task* task)
+    {
+        size_t index = this->count;
+
+        // Move tasks that must run before the given one towards the end
+        while (index > 0 && !DeadlineSupport::precedes(*task, *this->tasks[index - 1]))
+        {
+            this->tasks[index] = this->tasks[index - 1];
+
+            index -= 1;
+        }
+
+        this->tasks[index] = task;
+
+        this->count += 1;
+    }
+};
+
+#endif /* DeadlineQueue_hpp */
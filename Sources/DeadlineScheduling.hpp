@@ -0,0 +1,90 @@
+//
+//  DeadlineScheduling.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef DeadlineScheduling_hpp
+#define DeadlineScheduling_hpp
+
+#include <Scheduler/Scheduler.hpp>
+#include "DeadlineQueue.hpp"
+
+//
+// MARK: - Earliest Deadline First (EDF) Scheduling Policies
+//
+// Building blocks of a `Scheduler::Assembler` configuration that always runs the ready task with the earliest deadline.
+// The idle task is never put in the ready queue and runs only if no other task is ready.
+//
+// Since all event handlers share the same stack, a preempted handler must not resume before the one that preempts it completes.
+// EDF preserves this property, because a handler is preempted only by another one whose deadline is strictly earlier,
+// and any handler released afterwards that starts before the preempted one resumes must also have an earlier deadline.
+//
+namespace DeadlineScheduling
+{
+    ///
+    /// [Task Creation] Run the new task if its deadline is earlier than the running one
+    ///
+    /// @tparam S Type of the scheduler that provides `ready()` and `getIdleTask()`
+    ///
+    template <typename S>
+    struct PreemptEarlierDeadlineWithIdleTaskSupport
+    {
+        using Task = typename Scheduler::Traits::SchedulerTraits<S>::Task;
+
+        ///
+        /// Invoked when a task becomes ready to run
+        ///
+        /// @param current The running task
+        /// @param task The task that becomes ready
+        /// @return The task to run next.
+        ///
+        Task* onTaskCreated(Task* current, Task* task)
+        {
+            S* scheduler = static_cast<S*>(this);
+
+            if (current == scheduler->getIdleTask())
+            {
+                return task;
+            }
+
+            if (DeadlineSupport::precedes(*task, *current))
+            {
+                scheduler->ready(current);
+
+                return task;
+            }
+
+            scheduler->ready(task);
+
+            return current;
+        }
+    };
+
+    ///
+    /// [Task Termination] Run the ready task with the earliest deadline or the idle task if none
+    ///
+    /// @tparam S Type of the scheduler that provides `isReadyQueueEmpty()`, `next()` and `getIdleTask()`
+    ///
+    template <typename S>
+    struct RunEarliestDeadlineWithIdleTaskSupport
+    {
+        using Task = typename Scheduler::Traits::SchedulerTraits<S>::Task;
+
+        ///
+        /// Invoked when the running task completes
+        ///
+        /// @param current The task that completes
+        /// @return The task to run next.
+        ///
+        Task* onTaskTerminated([[maybe_unused]] Task* current)
+        {
+            S* scheduler = static_cast<S*>(this);
+
+            return scheduler->isReadyQueueEmpty() ? scheduler->getIdleTask() : scheduler->next();
+        }
+    };
+}
+
+#endif /* DeadlineScheduling_hpp */
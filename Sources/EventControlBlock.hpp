@@ -10,17 +10,36 @@
 
 #include <Types.hpp>
 #include <ARM/Context.hpp>
+#include "DeadlineQueue.hpp"
+#include "CpuAccounting.hpp"
+#include "ExecutionBudget.hpp"
+#include "KernelEntry.hpp"
+
 #include <Scheduler/Scheduler.hpp>
 #include <Execution/Common/TaskControlBlockComponents.hpp>
 
 using EventHandler = void(*)();
 using Event = unsigned int;
 
+/// Priority of an event handler (a larger value denotes a higher priority)
+using EventPriority = UInt32;
+
 struct EventControlBlock: Scheduler::Schedulable, Listable<EventControlBlock>,
         TaskControlBlockComponents::SharedStackSupport<EventControlBlock>,
         TaskControlBlockComponents::SystemCallSupport<EventControlBlock, Context>,
-        TaskControlBlockComponents::EventHandlerSupport<EventControlBlock, EventHandler>
+        TaskControlBlockComponents::EventHandlerSupport<EventControlBlock, EventHandler>,
+        DeadlineSupport,
+        CpuTimeSupport,
+        ExecutionBudgetSupport,
+        SyscallRegisterArgumentSupport<EventControlBlock>
 {
+    /// System call numbers are encoded in `svc`, so arguments start at r0 rather than r1
+    using SyscallRegisterArgumentSupport::getSyscallArgument;
+
+    /// The shared stack pointer before the trampoline context of the handler was built
+    /// It is restored if the kernel aborts the handler, which never returns through the trampoline (See `abortEventHandler()`).
+    UInt8* returnStack = nullptr;
+
     friend std::strong_ordering operator <=>(const EventControlBlock& lhs, const EventControlBlock& rhs)
     {
         return std::addressof(lhs) <=> std::addressof(rhs);
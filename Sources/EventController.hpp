@@ -11,6 +11,123 @@
 #include "EventControlBlock.hpp"
 #include <Execution/SimpleEventDriven/KernelServiceRoutines.hpp>
 
-using EventController = TableBasedEventController<EventControlBlock, Event, 4>;
+///
+/// A table-based event controller that assigns a priority to each event handler
+///
+struct EventController: TableBasedEventController<EventControlBlock, Event, 7>
+{
+    /// The number of events
+    static constexpr size_t kNumEvents = 7;
+
+    /// The number of topics (i.e. message types received from the peer, See `Message::Type`)
+    static constexpr size_t kNumTopics = 8;
+
+    static_assert(kNumEvents <= 32, "Subscribers of a topic are kept in a 32-bit mask.");
+
+    /// Events that subscribe to each topic (one bit per event)
+    UInt32 subscribers[kNumTopics] = {};
+
+    ///
+    /// Register the handler of the given event
+    ///
+    /// @param event The event identifier
+    /// @param handler The event handler
+    /// @param priority The priority of the handler
+    /// @note A handler preempts the running one only if it has a higher priority.
+    /// @note The idle handler must have the lowest priority.
+    ///
+    void registerEvent(Event event, EventHandler handler, EventPriority priority)
+    {
+        TableBasedEventController::registerEvent(event, handler);
+
+        this->getRegisteredEvent(event)->setPriority(priority);
+    }
+
+    ///
+    /// Register the handler of the given event with a deadline
+    ///
+    /// @param event The event identifier
+    /// @param handler The event handler
+    /// @param priority The priority of the handler
+    /// @param relativeDeadline Number of milliseconds allowed for the handler to complete once the event is posted
+    /// @note The deadline orders pending handlers if the kernel is built with `KERNEL_EDF_SCHEDULING`,
+    ///       and is used to report missed deadlines otherwise.
+    ///
+    void registerEvent(Event event, EventHandler handler, EventPriority priority, UInt32 relativeDeadline)
+    {
+        this->registerEvent(event, handler, priority);
+
+        this->getRegisteredEvent(event)->relativeDeadline = relativeDeadline;
+    }
+
+    ///
+    /// Register the handler of the given event with a deadline and an execution budget
+    ///
+    /// @param event The event identifier
+    /// @param handler The event handler
+    /// @param priority The priority of the handler
+    /// @param relativeDeadline Number of milliseconds allowed for the handler to complete once the event is posted
+    /// @param budget Number of milliseconds the handler may run each time the event is posted
+    /// @note The kernel aborts the handler once it has exhausted its budget.
+    ///
+    void registerEvent(Event event, EventHandler handler, EventPriority priority, UInt32 relativeDeadline, UInt32 budget)
+    {
+        this->registerEvent(event, handler, priority, relativeDeadline);
+
+        this->getRegisteredEvent(event)->budget = budget;
+    }
+
+    ///
+    /// Get the identifier of the event handled by the given control block
+    ///
+    /// @param block A control block registered with this controller
+    /// @return The event identifier, `kNumEvents` if the control block is not registered.
+    ///
+    Event getEventIdentifier(const EventControlBlock* block)
+    {
+        for (Event event = 0; event < kNumEvents; event += 1)
+        {
+            if (this->getRegisteredEvent(event) == block)
+            {
+                return event;
+            }
+        }
+
+        return kNumEvents;
+    }
+
+    ///
+    /// Subscribe the given event to the given topic
+    ///
+    /// @param topic The topic
+    /// @param event The event identifier
+    /// @return `true` on success, `false` if the topic or the event identifier is invalid, or if the event is the idle event.
+    /// @note Publishing the topic posts all subscribed events at once, and the scheduler runs their handlers in priority order.
+    /// @note The idle event never subscribes to a topic, otherwise publishing the topic would dispatch the idle handler.
+    ///
+    bool subscribe(UInt32 topic, Event event)
+    {
+        if (topic >= kNumTopics || event == 0 || event >= kNumEvents)
+        {
+            return false;
+        }
+
+        this->subscribers[topic] |= 1U << event;
+
+        return true;
+    }
+
+    ///
+    /// Get the events that subscribe to the given topic
+    ///
+    /// @param topic The topic
+    /// @return A bit mask of subscribed events, `0` if the topic is invalid.
+    ///
+    [[nodiscard]]
+    UInt32 getSubscribers(UInt32 topic) const
+    {
+        return topic < kNumTopics ? this->subscribers[topic] : 0;
+    }
+};
 
 #endif /* EventController_hpp */
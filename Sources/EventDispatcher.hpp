@@ -16,34 +16,140 @@
 #include "EventHandlerSwitcher.hpp"
 #include "EventScheduler.hpp"
 #include "UART/PL011.hpp"
+#include "UART/WireLink.hpp"
+#include "Watchdog/WatchdogTimer.hpp"
+#include "AlertDelivery.hpp"
+#include "SensorRegistry.hpp"
+#include "DataLog.hpp"
+#include "DeadlineMonitor.hpp"
+#include "PendingEventQueue.hpp"
+#include "EventTimer.hpp"
+#include "NativeInterrupt.hpp"
+#include "Mailboxes.hpp"
+#include "SyscallDispatchTable.hpp"
+#include "MemoryProtection.hpp"
 #include "Message.hpp"
 #include "EventController.hpp"
 #include "CMSIS/ARMCM3.h"
 
-extern EventControlBlock gEventTable[4];
-
-struct EventControlBlockMapper
-{
-    EventControlBlock* operator()(int event)
-    {
-        return KernelServiceRoutines::GetTaskController<EventController>().getRegisteredEvent(event);
-    }
-};
+extern EventControlBlock gEventTable[EventController::kNumEvents];
 
 //
 // MARK: - Define kernel service routine functions and the mapper for the dispatcher
 //
 namespace KernelServiceRoutines
 {
-    using SyscallSendEventRoutine = KernelServiceRoutines::SyscallSendEvent<EventControlBlock, EventScheduler, EventControlBlockMapper>;
-    OSDefineAndRouteKernelRoutine(kSyscallSendEventRoutine, EventControlBlock, SyscallSendEventRoutine)
-
     using SyscallEventHandlerReturnRoutine = KernelServiceRoutines::SyscallEventHandlerReturn<EventControlBlock, EventScheduler>;
     OSDefineAndRouteKernelRoutine(kSyscallEventHandlerReturnRoutine, EventControlBlock, SyscallEventHandlerReturnRoutine)
 
     using SyscallUnknownIdentifierRoutine = KernelServiceRoutines::UnknownServiceIdentifier<EventControlBlock>;
     OSDefineAndRouteKernelRoutine(kSyscallUnknownIdentifier, EventControlBlock, SyscallUnknownIdentifierRoutine)
 
+    /// Kernel uptime in milliseconds
+    static UInt32 kUptime = 0;
+
+    /// Posts of events whose handlers are still pending or running
+    static PendingEventQueue<EventController::kNumEvents, 8> kPendingEvents;
+
+    ///
+    /// Hand the handler of the given event to the scheduler
+    ///
+    /// @param current The running event handler
+    /// @param event Identifier of the event
+    /// @return The event handler to run next.
+    ///
+    static EventControlBlock* releaseEvent(EventControlBlock* current, Event event)
+    {
+        EventControlBlock* block = GetTaskController<EventController>().getRegisteredEvent(event);
+
+        // The deadline of the handler starts once it is handed to the scheduler
+        block->release(kUptime);
+
+        block->replenish();
+
+        return GetTaskScheduler<EventScheduler>().onTaskCreated(current, block);
+    }
+
+    ///
+    /// Post the given event subject to the overflow policy of the event
+    ///
+    /// @param current The running event handler
+    /// @param event Identifier of the event
+    /// @return The event handler to run next.
+    ///
+    static EventControlBlock* postEvent(EventControlBlock* current, Event event)
+    {
+        return kPendingEvents.post(event) ? releaseEvent(current, event) : current;
+    }
+
+    static WireLink kUART1Link(PL011::kUART1);
+
+    static AlertDelivery<4> kAlertDelivery(kUART1Link);
+
+    /// Moisture sensors in the bed and their 8 most recent samples
+    static SensorRegistry<4, 8> kSensors;
+
+    /// Sensor history and alerts that survive reboots
+    static DataLog<16> kDataLog;
+
+    /// Deadlines met and missed by each event handler
+    static DeadlineMonitor<EventController::kNumEvents> kDeadlineMonitor;
+
+    /// One-shot timers armed by event handlers
+    static EventTimers<EventController::kNumEvents> kEventTimers;
+
+#ifdef KERNEL_RUNTIME_REPORTS
+    /// `true` if the deadline and processor utilization reports are due (See `onDispatcherIdle()`)
+    static bool kReportsDue = false;
+#endif
+
+    ///
+    /// Serve the next post of the event whose handler has been retired
+    ///
+    /// @param current The event handler to run next
+    /// @param event Identifier of the event
+    /// @return The event handler to run next.
+    ///
+    static EventControlBlock* retireEventHandler(EventControlBlock* current, Event event)
+    {
+        // Serve the next post of the event that waits in the backlog
+        if (kPendingEvents.complete(event))
+        {
+            current = releaseEvent(current, event);
+        }
+
+        return current;
+    }
+
+    static EventControlBlock* kEventHandlerReturnRoutine(EventControlBlock* current)
+    {
+        Event event = GetTaskController<EventController>().getEventIdentifier(current);
+
+        kDeadlineMonitor.onHandlerCompleted(event, *current, kUptime);
+
+        return retireEventHandler(kSyscallEventHandlerReturnRoutine(current), event);
+    }
+
+    ///
+    /// Abort the running event handler
+    ///
+    /// @param current The running event handler
+    /// @param event Identifier of the event
+    /// @return The event handler to run next.
+    /// @note The handler is retired as if it had returned. Its frames are simply abandoned on the shared stack,
+    ///       since it always sits on top of the handlers it has preempted.
+    /// @note The kernel is not entered by the return system call, so the stacked registers hold no old stack pointer.
+    ///       The shared stack is unwound to the one recorded when the trampoline context was built.
+    ///
+    static EventControlBlock* abortEventHandler(EventControlBlock* current, Event event)
+    {
+        kDeadlineMonitor.onHandlerAborted(event);
+
+        current->setStackPointer(current->returnStack);
+
+        return retireEventHandler(GetTaskScheduler<EventScheduler>().onTaskTerminated(current), event);
+    }
+
     static EventControlBlock* kSysTickInterruptHandler(EventControlBlock* current)
     {
         /// Every 10 seconds
@@ -51,6 +157,36 @@ namespace KernelServiceRoutines
 
         pinfo("SysTick Interrupt.");
 
+        kUptime += 1;
+
+        // The kernel is alive as long as the timer interrupt is served
+        WatchdogTimer::feed();
+
+        // Charge the tick to the interrupted event handler
+        // The idle handler has no budget, so the kernel idling never exhausts it
+        if (current->charge(1))
+        {
+            Event event = GetTaskController<EventController>().getEventIdentifier(current);
+
+            pinfo("Event handler %d has run for %d ms and exceeded its budget. Aborted.", event, current->consumed);
+
+            kDataLog.append(DataLogRecord::kBudgetOverrun, event, current->consumed, kUptime);
+
+            current = abortEventHandler(current, event);
+        }
+
+        // Post events whose timer has expired
+        kEventTimers.tick([&](Event event)
+        {
+            current = postEvent(current, event);
+        });
+
+        // Mark alerts that have not been acknowledged by the actuator, which the dispatcher retransmits once it idles
+        kAlertDelivery.tick();
+
+        // Program buffered log records periodically
+        kDataLog.tick();
+
         timeout -= 1;
 
         if (timeout == 0)
@@ -58,8 +194,12 @@ namespace KernelServiceRoutines
             pinfo("Periodic Event Triggered.");
 
             timeout = 5000;
+#ifdef KERNEL_RUNTIME_REPORTS
+            // Printing takes a while, so the dispatcher prints the reports once it idles
+            kReportsDue = true;
+#endif
 
-            current = GetTaskScheduler<EventScheduler>().onTaskCreated(current, GetTaskController<EventController>().getRegisteredEvent(1));
+            current = postEvent(current, 1);
         }
         else
         {
@@ -69,71 +209,367 @@ namespace KernelServiceRoutines
         return current;
     }
 
-    static UInt32 kMoistureLevel = 0;
-
-    static EventControlBlock* kUART1ReceiveInterruptHandler(EventControlBlock* current)
+    ///
+    /// Serve the kernel work deferred by interrupt service routines
+    ///
+    /// @note The dispatcher calls this function each time it is about to idle,
+    ///       so that long operations (e.g. polled transmissions) never run in the timer interrupt.
+    ///
+    static void onDispatcherIdle()
     {
-        pmesg("UART1 RX Interrupt.");
+        // Retransmit alerts that have not been acknowledged by the actuator in time
+        kAlertDelivery.retransmit([](const WireProtocol::Reading& alert, UInt16 sequence)
+        {
+            // Alerts are rare and important, so program them right away
+            kDataLog.append(DataLogRecord::kAlertDropped, alert.type, sequence, kUptime);
+
+            kDataLog.flush();
+
+            // Hand the alert over to user handlers, which decide whether to post it again
+            if (!gDroppedAlertMailbox.send(alert))
+            {
+                pinfo("The dropped alert mailbox is full.");
+            }
+        });
+#ifdef KERNEL_RUNTIME_REPORTS
+        if (kReportsDue)
+        {
+            kReportsDue = false;
 
-        Message message = {};
+            kDeadlineMonitor.report();
 
-        PL011::receive(PL011::kUART1, message);
+            CpuAccounting::report(GetTaskController<EventController>(), EventController::kNumEvents);
+        }
+#endif
+    }
 
-        if (message.magic == 0x4657 && message.type == Message::Type::kChangeSoilMoisture)
+    ///
+    /// Wake up all event handlers that subscribe to the given topic
+    ///
+    /// @param topic The topic (See `Message::Type`)
+    /// @note This function is called by native handlers.
+    ///
+    static void publish(UInt32 topic)
+    {
+        NativeInterrupt::postAll(GetTaskController<EventController>().getSubscribers(topic));
+    }
+
+    static void onUART1ReadingReceived(const WireProtocol::Reading& reading)
+    {
+        switch (reading.type)
         {
-            kMoistureLevel = message.data;
+            case Message::Type::kChangeSoilMoisture:
+                if (kSensors.record(reading.sensor, kUptime, reading.value))
+                {
+                    kDataLog.append(reading.type, reading.sensor, reading.value, kUptime);
+
+                    pmesg("Environment: Moisture level of sensor %d has been changed to %d.", reading.sensor, reading.value);
+
+                    // The watering protocol confirms a dry soil with the next raw reading
+                    if (!gReadingMailbox.send(reading))
+                    {
+                        pmesg("Environment: The reading mailbox is full.");
+                    }
 
-            pmesg("Environment: Moisture level has been changed to %d.", kMoistureLevel);
+                    publish(reading.type);
+                }
+                else
+                {
+                    pmesg("Environment: Ignored a reading from the unknown sensor %d.", reading.sensor);
+                }
+
+                break;
+
+            case Message::Type::kChangeWaterStatus:
+                kDataLog.append(reading.type, reading.sensor, reading.value, kUptime);
+
+                pmesg("Environment: Water status has been changed to %d.", reading.value);
+
+                publish(reading.type);
+
+                break;
+
+            case Message::Type::kAckSoilWet:
+                if (kAlertDelivery.acknowledge(reading.value, Message::Type::kSoilWetAlert))
+                {
+                    pmesg("Actuator: Soil wet alert #%d has been acknowledged.", reading.value);
+                }
+
+                break;
+
+            case Message::Type::kAckAlert:
+                if (kAlertDelivery.acknowledge(reading.value))
+                {
+                    pmesg("Actuator: Alert #%d has been acknowledged.", reading.value);
+                }
+
+                break;
+
+            default:
+                pmesg("Environment: Ignored a reading of type %d.", reading.type);
+
+                break;
+        }
+    }
+
+    ///
+    /// Drain the frames received by UART1
+    ///
+    /// @note This is a native interrupt handler that runs without entering the kernel (See `NativeInterrupt`).
+    ///
+    static void kUART1ReceiveNativeHandler()
+    {
+        pmesg("UART1 RX Interrupt.");
+
+        size_t discarded = kUART1Link.receive(onUART1ReadingReceived);
+
+        if (discarded != 0)
+        {
+            pmesg("Environment: Discarded %d corrupted frame(s).", discarded);
         }
 
         PL011::clearRxInterrupt(PL011::kUART1);
 
-        return current;
+        PL011::clearRxTimeoutInterrupt(PL011::kUART1);
     }
 
-    static EventControlBlock* kReadSensorRoutine(EventControlBlock* current)
+    static EventControlBlock* kNativeInterruptPostRoutine(EventControlBlock* current)
     {
-        current->setSyscallKernelReturnValue(kMoistureLevel);
+        UInt32 events = NativeInterrupt::takePostedEvents();
+
+        for (Event event = 0; events != 0; event += 1, events >>= 1)
+        {
+            if (events & 1)
+            {
+                current = postEvent(current, event);
+            }
+        }
 
         return current;
     }
 
-    static EventControlBlock* kSendDataRoutine(EventControlBlock* current)
+    //
+    // MARK: - System Call Routines
+    //
+    // Each routine serves the system call of the same identifier in the system call table with the typed arguments.
+    // A routine returns the value for the caller, or the event handler to run next if the system call returns nothing.
+    //
+
+    ///
+    /// Rejects system calls whose pointer arguments the calling event handler may not access
+    ///
+    struct SyscallGuard: MemoryProtection::UserAccess
     {
-        const void* data = current->getSyscallArgument<const void*>();
+        ///
+        /// Abort the event handler as if it had accessed the memory itself
+        ///
+        static EventControlBlock* reject(EventControlBlock* current, int identifier, const void* address)
+        {
+            Event event = GetTaskController<EventController>().getEventIdentifier(current);
 
-        auto count = current->getSyscallArgument<size_t>();
+            pinfo("Event handler %d has passed the inaccessible address %p to system call %d. Aborted.", event, address, identifier);
 
-        PL011::send(PL011::kUART1, data, count);
+            // The data log keeps 16-bit values, which is enough to locate the address in the SRAM
+            kDataLog.append(DataLogRecord::kMemoryFault, event, reinterpret_cast<UInt32>(address) & 0xFFFF, kUptime);
 
-        current->setSyscallKernelReturnValue(count);
+            return abortEventHandler(current, event);
+        }
+    };
 
-        return current;
-    }
+    template <int Identifier>
+    struct SyscallRoutine;
 
-#ifndef RUN_STACK_EXP
-    static EventControlBlock* kPrintRoutine(EventControlBlock* current)
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::SetEventHandler>
     {
-        const char* format = current->getSyscallArgument<const char*>();
+        static EventControlBlock* serve(EventControlBlock* current, Event event, EventHandler handler, EventPriority priority)
+        {
+            GetTaskController<EventController>().registerEvent(event, handler, priority);
 
-        auto args = current->getSyscallArgument<va_list*>();
+            return current;
+        }
+    };
 
-        kvprintf(format, *args);
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::SendEvent>
+    {
+        static EventControlBlock* serve(EventControlBlock* current, Event event)
+        {
+            return postEvent(current, event);
+        }
+    };
 
-        return current;
-    }
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::EventHandlerReturn>
+    {
+        // The library routine reads the old stack pointer by itself
+        static EventControlBlock* serve(EventControlBlock* current, UInt8*)
+        {
+            return kEventHandlerReturnRoutine(current);
+        }
+    };
+
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::ReadSensor>
+    {
+        static int serve(EventControlBlock*, size_t sensor, UInt32* value)
+        {
+            const Sample* sample = kSensors.getLatestSample(sensor);
+
+            if (sample == nullptr)
+            {
+                return -1;
+            }
+
+            *value = sample->value;
+
+            return 0;
+        }
+    };
+
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::SendData>
+    {
+        static size_t serve(EventControlBlock*, const void* data, size_t count)
+        {
+            PL011::send(PL011::kUART1, data, count);
+
+            return count;
+        }
+    };
+
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::Print>
+    {
+        static EventControlBlock* serve(EventControlBlock* current, const char* format, UInt32 first, UInt32 second, UInt32 third)
+        {
+            // The kernel would otherwise print kernel memory on behalf of the handler through `%s`
+            const UInt32 values[] = { first, second, third };
+
+            const void* violation = nullptr;
+
+            if (!SyscallGuard::canPrint(format, values, 3, violation))
+            {
+                return SyscallGuard::reject(current, SyscallIdentifiers::Print, violation);
+            }
+#ifndef RUN_STACK_EXP
+            // Unused values are ignored by the format string
+            kprintf(format, first, second, third);
 #endif
+            return current;
+        }
+    };
 
-    static EventControlBlock* kSetEventHandler(EventControlBlock* current)
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::SendReadings>
     {
-        auto event = current->getSyscallArgument<Event>();
+        static size_t serve(EventControlBlock*, const WireProtocol::Reading* readings, size_t count)
+        {
+            kUART1Link.send(readings, count);
 
-        auto handler = current->getSyscallArgument<EventHandler>();
+            return count;
+        }
+    };
 
-        GetTaskController<EventController>().registerEvent(event, handler);
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::PostAlert>
+    {
+        static int serve(EventControlBlock*, UInt32 type, UInt32 value)
+        {
+            int sequence = kAlertDelivery.post(type, value);
 
-        return current;
-    }
+            // Alerts are rare and important, so program them right away
+            kDataLog.append(type, 0, value, kUptime);
+
+            kDataLog.flush();
+
+            return sequence;
+        }
+    };
+
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::ReadSensorSamples>
+    {
+        static size_t serve(EventControlBlock*, size_t sensor, Sample* samples, size_t count)
+        {
+            return kSensors.copySamples(sensor, samples, count);
+        }
+    };
+
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::ReadSensorStatistics>
+    {
+        static int serve(EventControlBlock*, size_t sensor, SensorStatistics* output)
+        {
+            const SensorStatistics* statistics = kSensors.getStatistics(sensor);
+
+            if (statistics == nullptr)
+            {
+                return -1;
+            }
+
+            *output = *statistics;
+
+            return 0;
+        }
+    };
+
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::DumpLog>
+    {
+        static size_t serve(EventControlBlock*, UInt32 position)
+        {
+            // A single frame is sent per call, so the caller drains the log without disabling interrupts for long
+            return kDataLog.stream(kUART1Link, position);
+        }
+    };
+
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::ReadEventStatistics>
+    {
+        static int serve(EventControlBlock*, Event event, EventStatistics* output)
+        {
+            const EventStatistics* statistics = kPendingEvents.getStatistics(event);
+
+            if (statistics == nullptr)
+            {
+                return -1;
+            }
+
+            *output = *statistics;
+
+            return 0;
+        }
+    };
+
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::ReadUptime>
+    {
+        static UInt32 serve(EventControlBlock*)
+        {
+            return kUptime;
+        }
+    };
+
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::SetTimer>
+    {
+        static int serve(EventControlBlock*, Event event, UInt32 milliseconds)
+        {
+            return kEventTimers.arm(event, milliseconds) ? 0 : -1;
+        }
+    };
+
+    template <>
+    struct SyscallRoutine<SyscallIdentifiers::Subscribe>
+    {
+        static int serve(EventControlBlock*, UInt32 topic, Event event)
+        {
+            return GetTaskController<EventController>().subscribe(topic, event) ? 0 : -1;
+        }
+    };
+
+    using SyscallRoutines = SyscallDispatchTable<EventControlBlock, SyscallRoutine, SyscallGuard>;
 }
 
 struct EventDispatcherRoutineMapper
@@ -142,40 +578,25 @@ struct EventDispatcherRoutineMapper
 
     using Routine = Task* (*)(Task*);
 
-    using ServiceIdentifier = int;
+    using ServiceIdentifier = KernelEntry;
 
-    Routine operator()(const ServiceIdentifier& identifier)
+    Routine operator()(const ServiceIdentifier& entry)
     {
         using namespace KernelServiceRoutines;
 
-        switch (identifier)
+        if (entry.isSyscall())
         {
-            case 0:
-                return kSetEventHandler;
-
-            case 1:
-                return kSyscallSendEventRoutine;
-
-            case 2:
-                return kSyscallEventHandlerReturnRoutine;
-
-            case 3:
-                return kReadSensorRoutine;
-
-            case 4:
-                return kSendDataRoutine;
+            return SyscallRoutines::lookup(entry.identifier, kSyscallUnknownIdentifier);
+        }
 
-#ifndef RUN_STACK_EXP
-            case 5:
-                return kPrintRoutine;
-#endif
+        switch (entry.exception)
+        {
+            case NativeInterrupt::kPostVector:
+                return &kNativeInterruptPostRoutine;
 
             case 15:
                 return &kSysTickInterruptHandler;
 
-            case 22:
-                return &kUART1ReceiveInterruptHandler;
-
             default:
                 return kSyscallUnknownIdentifier;
         }
@@ -192,6 +613,6 @@ using Injector = PreemptiveEventHandlerTrampolineContextInjector<EventControlBlo
 // MARK: - Assemble a custom dispatcher for a simple event-driven system
 //
 
-using EventDispatcher = Dispatcher<EventControlBlock, int, EventDispatcherRoutineMapper, EventHandlerSwitcher, Injector>;
+using EventDispatcher = Dispatcher<EventControlBlock, KernelEntry, EventDispatcherRoutineMapper, EventHandlerSwitcher, Injector>;
 
 #endif /* EventDispatcher_hpp */
@@ -11,23 +11,92 @@
 #include "EventControlBlock.hpp"
 #include "EventController.hpp"
 #include <Debug.hpp>
+#include "BootTrace.hpp"
+#include "SyscallProfiler.hpp"
+#include "CpuAccounting.hpp"
+#include "KernelIdle.hpp"
+#include "NativeInterrupt.hpp"
+#include "KernelEntry.hpp"
+#include "CrashDump.hpp"
 
 extern "C" void KernelEntryPoint();
 
 volatile UInt8* gUserStack;
 
+/// Written by the kernel entry stub before the kernel resumes
+inline KernelEntry gKernelEntry;
+
+/// The event handler that runs in thread mode or `nullptr` if the kernel idles
+inline EventControlBlock* gRunningHandler = nullptr;
+
+namespace KernelServiceRoutines
+{
+    /// Serve the kernel work deferred by interrupt service routines (Defined in `EventDispatcher.hpp`)
+    static void onDispatcherIdle();
+}
+
+/// The most recently dispatched event handlers, captured in the crash dump
+inline DispatchHistory<EventControlBlock, CrashDump::kHistoryDepth> gDispatchHistory;
+
 struct EventHandlerSwitcher
 {
-    using ServiceIdentifier = int;
+    using ServiceIdentifier = KernelEntry;
 
     using Task = EventControlBlock;
 
-    static int switchTask(EventControlBlock* prev, EventControlBlock* next)
+    ///
+    /// Switch from the given event handler to the next one
+    ///
+    /// @note This function defines the global assembly label `KernelEntryPoint`,
+    ///       so it must never be inlined or cloned, otherwise the label would be emitted more than once.
+    ///
+    __attribute__((noinline, noclone))
+    static KernelEntry switchTask(EventControlBlock* prev, EventControlBlock* next)
     {
         auto& controller = KernelServiceRoutines::GetTaskController<EventController>();
 
         //pinfo("Will switch from handler %d to %d.", controller.getEventID(prev), controller.getEventID(next));
 
+        SyscallProfiler::onKernelExit();
+
+        CpuAccounting::onKernelExit();
+
+        gDispatchHistory.record(next);
+
+        BootTrace::onDispatch();
+
+        // Print the boot trace once the dispatcher runs the idle handler for the first time
+        // and kernel service statistics periodically if profiling is enabled
+        if (next == controller.getRegisteredEvent(0))
+        {
+            KernelServiceRoutines::onDispatcherIdle();
+
+            BootTrace::finish();
+
+            SyscallProfiler::reportIfNeeded();
+
+            // The idle handler never runs in thread mode
+            // Instead, the kernel sleeps until an interrupt arrives and serves it on behalf of the idle handler
+            pinfo("==> Idle");
+
+            gRunningHandler = nullptr;
+
+            // Native interrupts are served in place until one of them posts an event
+            UInt32 irq;
+
+            while (NativeInterrupt::serve(irq = KernelIdle::waitForInterrupt()));
+
+            pinfo("Idle <== IRQ number is %d.", irq);
+
+            CpuAccounting::onKernelEntry(*next, true);
+
+            SyscallProfiler::onKernelEntry(irq);
+
+            return KernelEntry::fromInterrupt(irq);
+        }
+
+        gRunningHandler = next;
+
         gUserStack = next->getStackPointer();
 
         pinfo("Shared user stack pointer at %p.", gUserStack);
@@ -80,7 +149,25 @@ struct EventHandlerSwitcher
                      // Save the user stack pointer
                      "ldr r1, =gUserStack \n"
                      "str r0, [r1] \n"
-                     
+
+                     // Decode the reason of the kernel entry once (See `KernelEntry`)
+                     // IPSR holds the exception number
+                     "mrs r1, IPSR \n"
+
+                     // The system call number is the immediate of the `svc` instruction right before the stacked return address
+                     // The stacked PC lies above the callee-saved registers and r0-r3, r12, LR in the exception frame
+                     "cmp r1, #11 \n"
+                     "ite eq \n"
+                     "ldreq r2, [r0, #56] \n"
+                     "movne r2, r1 \n"
+                     "it eq \n"
+                     "ldrbeq r2, [r2, #-2] \n"
+
+                     // Save the record
+                     "ldr r3, =gKernelEntry \n"
+                     "strb r1, [r3] \n"
+                     "strb r2, [r3, #1] \n"
+
                      // Restore all flags, the return address and all general-purpose registers from the kernel stack
                      "pop {r0} \n"
                      "msr PSR, r0 \n"
@@ -97,18 +184,22 @@ struct EventHandlerSwitcher
 
         next->setStackPointer((UInt8*) gUserStack);
 
-        // The low 8 bits in the ICSR register stores the current IRQ handler number
-        UInt32 irq = *reinterpret_cast<volatile UInt32*>(0xE000ED04) & 0xFF;
+        KernelEntry entry = gKernelEntry;
+
+        pinfo("IRQ number is %d. Service identifier is %d.", entry.exception, entry.identifier);
 
-        pinfo("IRQ number is %d.", irq);
+        // Charge the time since the last kernel exit to the event handler that was running
+        CpuAccounting::onKernelEntry(*next, !entry.isSyscall());
 
-        // Check whether users have invoked a system call
-        if (irq == 11)
+        // System call arguments start at r0
+        if (entry.isSyscall())
         {
-            irq = reinterpret_cast<Context*>(next->getStackPointer())->r0;
+            next->resetSyscallArguments();
         }
 
-        return irq;
+        SyscallProfiler::onKernelEntry(entry.identifier);
+
+        return entry;
     }
 };
 
@@ -25,6 +25,8 @@ struct EventHandlerTrampolineContextBuilder_ARM
         // Preserve the stack pointer to switch back to the previous event handler
         UInt8* oldStack = sp;
 
+        next->returnStack = oldStack;
+
         // Set up the execution context for the trampoline function
         sp -= sizeof(Context);
 
@@ -12,6 +12,10 @@
 #include "EventControlBlock.hpp"
 #include "EventController.hpp"
 
+#ifdef KERNEL_EDF_SCHEDULING
+#include "DeadlineScheduling.hpp"
+#endif
+
 struct EventScheduler;
 
 namespace Scheduler::Traits
@@ -23,10 +27,19 @@ namespace Scheduler::Traits
     };
 }
 
+#ifdef KERNEL_EDF_SCHEDULING
+// Run the pending event handler with the earliest deadline
+struct EventScheduler: public Scheduler::Assembler<
+    EarliestDeadlineFirstQueue<EventControlBlock, EventController::kNumEvents>,
+    DeadlineScheduling::PreemptEarlierDeadlineWithIdleTaskSupport<EventScheduler>,
+    DeadlineScheduling::RunEarliestDeadlineWithIdleTaskSupport<EventScheduler>>
+#else
+// Run the pending event handler with the highest static priority
 struct EventScheduler: public Scheduler::Assembler<
     Scheduler::Policies::PrioritizedSingleQueue::Normal::LinkedListImp<EventControlBlock>,
     Scheduler::EventHandlers::TaskCreation::Preemptive::RunHigherPriorityWithIdleTaskSupport<EventScheduler>,
     Scheduler::EventHandlers::TaskTermination::Common::RunNextWithIdleTaskSupport<EventScheduler>>
+#endif
 {
     ///
     /// Get the idle task
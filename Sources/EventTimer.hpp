@@ -0,0 +1,65 @@
+//
+//  EventTimer.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef EventTimer_hpp
+#define EventTimer_hpp
+
+#include <Types.hpp>
+
+///
+/// One-shot timers that post an event once they expire
+///
+/// Each event has at most one timer, and arming the timer of an event replaces the previous one.
+///
+/// @tparam NumEvents The number of events
+/// @note All functions must be called with interrupts disabled (i.e. in the kernel).
+///
+template <size_t NumEvents>
+class EventTimers
+{
+    /// Number of milliseconds until the timer of each event expires (`0` if disarmed)
+    UInt32 remaining[NumEvents] = {};
+
+public:
+    ///
+    /// Arm the timer of the given event
+    ///
+    /// @param event Identifier of the event
+    /// @param milliseconds Number of milliseconds until the event is posted, `0` to disarm the timer
+    /// @return `true` on success, `false` if the event is invalid.
+    ///
+    bool arm(size_t event, UInt32 milliseconds)
+    {
+        if (event >= NumEvents)
+        {
+            return false;
+        }
+
+        this->remaining[event] = milliseconds;
+
+        return true;
+    }
+
+    ///
+    /// Advance all timers by a millisecond
+    ///
+    /// @param expire A callable object invoked with the identifier of each event whose timer expires
+    ///
+    template <typename Callback>
+    void tick(Callback expire)
+    {
+        for (size_t event = 0; event < NumEvents; event += 1)
+        {
+            if (this->remaining[event] != 0 && --this->remaining[event] == 0)
+            {
+                expire(event);
+            }
+        }
+    }
+};
+
+#endif /* EventTimer_hpp */
@@ -0,0 +1,58 @@
+//
+//  ExecutionBudget.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef ExecutionBudget_hpp
+#define ExecutionBudget_hpp
+
+#include <Types.hpp>
+
+///
+/// A component that limits the time a task may run each time it is released
+///
+/// The timer interrupt charges each tick to the task it interrupts,
+/// so the budget counts the time the task runs rather than the time it waits for preempting tasks.
+///
+struct ExecutionBudgetSupport
+{
+    /// Indicates that the task may run for as long as it needs
+    static constexpr UInt32 kNoBudget = 0;
+
+    /// Number of milliseconds the task may run each time it is released (`kNoBudget` if unlimited)
+    UInt32 budget = kNoBudget;
+
+    /// Number of milliseconds the task has run since it was released
+    UInt32 consumed = 0;
+
+    [[nodiscard]]
+    bool hasBudget() const
+    {
+        return this->budget != kNoBudget;
+    }
+
+    ///
+    /// Restore the full budget when the task is released
+    ///
+    void replenish()
+    {
+        this->consumed = 0;
+    }
+
+    ///
+    /// Charge the given amount of time to the task
+    ///
+    /// @param elapsed Number of milliseconds the task has run
+    /// @return `true` if the task has exhausted its budget, `false` otherwise.
+    ///
+    bool charge(UInt32 elapsed)
+    {
+        this->consumed += elapsed;
+
+        return this->hasBudget() && this->consumed > this->budget;
+    }
+};
+
+#endif /* ExecutionBudget_hpp */
@@ -0,0 +1,215 @@
+//
+//  FaultHandler.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef FaultHandler_hpp
+#define FaultHandler_hpp
+
+#include <Debug.hpp>
+#include "EventDispatcher.hpp"
+#include "EventHandlerSwitcher.hpp"
+#include "MemoryProtection.hpp"
+#include "CrashDump.hpp"
+#include "Message.hpp"
+#include "DataLogRecord.hpp"
+#include "CMSIS/ARMCM3.h"
+
+extern UInt8 gUserStackStart;
+
+//
+// MARK: - Fault Handlers
+//
+// All fault exceptions (i.e. Hard Fault, Memory Management, Bus Fault and Usage Fault) share the same handler.
+// A fault in an event handler raises the corresponding exception,
+// while a fault in the kernel escalates to a hard fault because the kernel runs with interrupts disabled.
+//
+// The handler captures a crash dump into retained RAM and resets the system right away,
+// so that the device resumes within milliseconds. The dump is reported on the next boot (See `reportCrashDump()`).
+//
+
+///
+/// Get the identifier of the event handled by the given handler
+///
+static inline UInt8 getCrashDumpEvent(const EventControlBlock* handler)
+{
+    if (handler == nullptr)
+    {
+        return CrashDump::kNoEvent;
+    }
+
+    Event event = KernelServiceRoutines::GetTaskController<EventController>().getEventIdentifier(handler);
+
+    return event < EventController::kNumEvents ? event : CrashDump::kNoEvent;
+}
+
+///
+/// Capture the crash dump and reset the system
+///
+/// @param frame Address of the frame stacked by the processor on exception entry
+/// @param excReturn EXC_RETURN value of the fault handler
+/// @note The function runs on the main stack and must not touch the user stack.
+///
+extern "C" __attribute__((used, noreturn))
+void CrashDumpCapture(const UInt32* frame, UInt32 excReturn)
+{
+    CrashDump& dump = gCrashDump;
+
+    dump.exception = SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk;
+
+    dump.cfsr = SCB->CFSR;
+
+    dump.hfsr = SCB->HFSR;
+
+    dump.mmfar = SCB->MMFAR;
+
+    dump.bfar = SCB->BFAR;
+
+    dump.excReturn = excReturn;
+
+    dump.stackPointer = reinterpret_cast<UInt32>(frame);
+
+    // The frame may be incomplete or inaccessible if the processor failed to stack it (e.g. the user stack has overflowed)
+    bool stacked = (dump.cfsr & (SCB_CFSR_MSTKERR_Msk | SCB_CFSR_STKERR_Msk)) == 0 &&
+                   !MemoryProtection::isStackGuard(dump.stackPointer, &gUserStackStart);
+
+    for (size_t index = 0; index < 8; index += 1)
+    {
+        dump.frame[index] = stacked ? frame[index] : 0;
+    }
+
+    dump.uptime = KernelServiceRoutines::kUptime;
+
+    dump.event = getCrashDumpEvent(gRunningHandler);
+
+    size_t index = 0;
+
+    gDispatchHistory.forEach([&](const EventControlBlock* handler)
+    {
+        dump.history[index++] = getCrashDumpEvent(handler);
+    });
+
+    dump.seal();
+
+    NVIC_SystemReset();
+}
+
+///
+/// Entry point of all fault exceptions
+///
+/// Passes the stacked frame and the EXC_RETURN value to `CrashDumpCapture()`.
+/// Bit 2 of EXC_RETURN tells whether the processor stacked the frame on the process stack (event handlers) or the main stack (kernel).
+///
+extern "C" __attribute__((naked))
+void FaultEntryPoint()
+{
+    asm volatile("tst lr, #4 \n"
+                 "ite eq \n"
+                 "mrseq r0, MSP \n"
+                 "mrsne r0, PSP \n"
+                 "mov r1, lr \n"
+                 "b CrashDumpCapture \n"
+                 );
+}
+
+///
+/// Report the crash dump captured before the last reset, if any
+///
+/// The dump is printed on UART0, sent to the peer over UART1 as readings of type `kCrashDump`
+/// (the sensor is the index of the field and the value is the field), and its summary is written to the data log.
+/// A memory protection violation is additionally reported as a reading of type `kMemoryFault`.
+///
+/// @note This function must be called after UART1 and the data log are ready.
+///
+__attribute__((cold))
+static void reportCrashDump()
+{
+    using namespace KernelServiceRoutines;
+
+    CrashDump& dump = gCrashDump;
+
+    if (!dump.isValid())
+    {
+        return;
+    }
+
+    kprintf("=========================== Crash Dump ============================\n");
+
+    kprintf("Exception = %u, Event = %u, Uptime = %u ms.\n", dump.exception, dump.event, dump.uptime);
+
+    kprintf("CFSR = 0x%08x, HFSR = 0x%08x, MMFAR = 0x%08x, BFAR = 0x%08x.\n", dump.cfsr, dump.hfsr, dump.mmfar, dump.bfar);
+
+    kprintf("EXC_RETURN = 0x%08x, SP = 0x%08x.\n", dump.excReturn, dump.stackPointer);
+
+    kprintf("R0 = 0x%08x, R1 = 0x%08x, R2 = 0x%08x, R3 = 0x%08x.\n", dump.frame[0], dump.frame[1], dump.frame[2], dump.frame[3]);
+
+    kprintf("R12 = 0x%08x, LR = 0x%08x, PC = 0x%08x, xPSR = 0x%08x.\n", dump.frame[4], dump.frame[5], dump.frame[6], dump.frame[7]);
+
+    kprintf("Recently dispatched events (oldest first):");
+
+    for (UInt8 event : dump.history)
+    {
+        kprintf(" %u", event);
+    }
+
+    kprintf("\n===================================================================\n");
+
+    // Stream all fields to the peer
+    const UInt32 fields[] =
+    {
+        dump.exception, dump.cfsr, dump.hfsr, dump.mmfar, dump.bfar, dump.excReturn, dump.stackPointer,
+        dump.frame[0], dump.frame[1], dump.frame[2], dump.frame[3], dump.frame[4], dump.frame[5], dump.frame[6], dump.frame[7],
+        dump.uptime, dump.event,
+        dump.history[0], dump.history[1], dump.history[2], dump.history[3],
+        dump.history[4], dump.history[5], dump.history[6], dump.history[7],
+    };
+
+    WireProtocol::Reading readings[sizeof(fields) / sizeof(UInt32)];
+
+    for (size_t index = 0; index < sizeof(fields) / sizeof(UInt32); index += 1)
+    {
+        readings[index] = {DataLogRecord::kCrashDump, static_cast<UInt8>(index), fields[index]};
+    }
+
+    kUART1Link.send(readings, sizeof(fields) / sizeof(UInt32));
+
+    // The data log is not prepared if its region could not be opened at boot
+    bool logged = kDataLog.isValid();
+
+    if (logged)
+    {
+        kDataLog.append(DataLogRecord::kCrashDump, dump.event, dump.exception, dump.uptime);
+    }
+
+    // The memory management fault status occupies the lowest byte of CFSR
+    if ((dump.cfsr & 0xFF) != 0)
+    {
+        UInt32 address = (dump.cfsr & SCB_CFSR_MMARVALID_Msk) ? dump.mmfar : 0;
+
+        if ((dump.cfsr & SCB_CFSR_MSTKERR_Msk) || MemoryProtection::isStackGuard(address, &gUserStackStart))
+        {
+            pinfo("Event handler %d has overflowed the shared user stack.", dump.event);
+        }
+
+        WireProtocol::Reading diagnostic = {DataLogRecord::kMemoryFault, dump.event, address};
+
+        kUART1Link.send(&diagnostic, 1);
+
+        // The data log keeps 16-bit values, which is enough to locate the address in the SRAM
+        if (logged)
+        {
+            kDataLog.append(diagnostic.type, diagnostic.sensor, address & 0xFFFF, dump.uptime);
+        }
+    }
+
+    if (logged)
+    {
+        kDataLog.flush();
+    }
+
+    dump.invalidate();
+}
+
+#endif /* FaultHandler_hpp */
@@ -0,0 +1,115 @@
+//
+//  FlashController.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef FlashController_hpp
+#define FlashController_hpp
+
+#include <Types.hpp>
+
+///
+/// Driver of the on-chip flash memory controller of Stellaris LM3S811
+///
+/// @note The flash is organized in 1 KB pages. A page must be erased (i.e. all bits set) before it can be programmed.
+/// @note The processor stalls instruction fetches from the flash while a program or an erase operation is in progress.
+/// @ref Section 7 Internal Memory in LM3S811 Manual
+///
+namespace FlashController
+{
+    /// Size of a flash page in bytes
+    static constexpr UInt32 kPageSize = 1024;
+
+    /// Value of an erased word
+    static constexpr UInt32 kErasedWord = 0xFFFFFFFF;
+
+    namespace Registers
+    {
+        static constexpr UInt32 rFMA    = 0x400FD000;
+        static constexpr UInt32 rFMD    = 0x400FD004;
+        static constexpr UInt32 rFMC    = 0x400FD008;
+        static constexpr UInt32 rFCRIS  = 0x400FD00C;
+        static constexpr UInt32 rFCMISC = 0x400FD014;
+    }
+
+    namespace Commands
+    {
+        /// The write key must accompany every command written to FMC
+        static constexpr UInt32 kWriteKey = 0xA4420000;
+
+        static constexpr UInt32 kWrite = 1 << 0;
+
+        static constexpr UInt32 kErase = 1 << 1;
+    }
+
+    static inline UInt32 readRegister32(UInt32 address)
+    {
+        return *reinterpret_cast<volatile UInt32*>(address);
+    }
+
+    static inline void writeRegister32(UInt32 address, UInt32 value)
+    {
+        *reinterpret_cast<volatile UInt32*>(address) = value;
+    }
+
+    ///
+    /// Run the given command on the given address and wait until the controller completes it
+    ///
+    /// @param address The flash address
+    /// @param command The command
+    /// @return `true` on success, `false` if the controller reports an access violation.
+    ///
+    static inline bool run(UInt32 address, UInt32 command)
+    {
+        // Clear any previous access violation
+        writeRegister32(Registers::rFCMISC, 0x1);
+
+        writeRegister32(Registers::rFMA, address);
+
+        writeRegister32(Registers::rFMC, Commands::kWriteKey | command);
+
+        while (readRegister32(Registers::rFMC) & command);
+
+        return (readRegister32(Registers::rFCRIS) & 0x1) == 0;
+    }
+
+    ///
+    /// Erase the page that starts at the given address
+    ///
+    /// @param address Start address of the page
+    /// @return `true` on success, `false` otherwise.
+    ///
+    static inline bool erasePage(UInt32 address)
+    {
+        return run(address, Commands::kErase);
+    }
+
+    ///
+    /// Program a word at the given address
+    ///
+    /// @param address A word-aligned address in an erased area
+    /// @param value The value to program
+    /// @return `true` on success, `false` otherwise.
+    ///
+    static inline bool programWord(UInt32 address, UInt32 value)
+    {
+        writeRegister32(Registers::rFMD, value);
+
+        return run(address, Commands::kWrite);
+    }
+
+    ///
+    /// Read a word at the given address
+    ///
+    /// @param address A word-aligned flash address
+    /// @return The value of the word.
+    ///
+    static inline UInt32 readWord(UInt32 address)
+    {
+        return readRegister32(address);
+    }
+}
+
+#endif /* FlashController_hpp */
@@ -0,0 +1,494 @@
+//
+//  HandlerCoroutine.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef HandlerCoroutine_hpp
+#define HandlerCoroutine_hpp
+
+#include <Types.hpp>
+#include <coroutine>
+#include "Syscall.hpp"
+#include "User.hpp"
+
+//
+// MARK: - Coroutine Event Handlers
+//
+// Event handlers run to completion on the shared stack, so a multi-step protocol would otherwise be split across handlers.
+// A coroutine instead suspends at `co_await` and keeps its state in a frame taken from a fixed pool,
+// so it holds no stack memory while it waits for an event or a timer.
+// It is resumed by the handler of the event it waits for, on top of the shared stack, and runs until it suspends again.
+//
+// Usage:
+// ```
+// HandlerCoroutine protocol()
+// {
+//     co_await Coroutines::nextEvent(kSensorEvent);
+//
+//     co_await Coroutines::sleepFor(1000);
+// }
+//
+// // Register `Coroutines::resume<kSensorEvent>` and `Coroutines::resumeSleepers` as event handlers
+// Coroutines::spawn(kSensorEvent, protocol);
+// ```
+//
+// If a step of a coroutine never returns (e.g. the kernel aborts the handler that exceeds its budget or faults),
+// the next handler that resumes a coroutine releases its frame and spawns it again from the start.
+//
+// @note Event handlers run unprivileged and may only access the shared user memory (See `MemoryProtection`),
+//       so the frame pool and the runtime state live in the `.userdata` section, which the kernel clears at boot.
+// @note A coroutine must be resumed by handlers of the same priority, since it is not reentrant.
+//
+
+///
+/// A fixed pool of coroutine frames
+///
+/// @tparam FrameSize The maximum size of a frame in bytes
+/// @tparam Capacity The number of frames
+///
+template <size_t FrameSize, size_t Capacity>
+class CoroutineFramePool
+{
+    alignas(8) UInt8 frames[Capacity][FrameSize];
+
+    bool used[Capacity];
+
+public:
+    ///
+    /// Allocate a frame of the given size
+    ///
+    /// @param size Size of the frame requested by the compiler
+    /// @return The frame on success, `nullptr` if the frame is too large or the pool is exhausted.
+    ///
+    void* allocate(size_t size)
+    {
+        if (size > FrameSize)
+        {
+            return nullptr;
+        }
+
+        for (size_t index = 0; index < Capacity; index += 1)
+        {
+            if (!this->used[index])
+            {
+                this->used[index] = true;
+
+                return this->frames[index];
+            }
+        }
+
+        return nullptr;
+    }
+
+    ///
+    /// Release the given frame
+    ///
+    void deallocate(void* frame)
+    {
+        this->used[(static_cast<UInt8*>(frame) - this->frames[0]) / FrameSize] = false;
+    }
+};
+
+///
+/// Return type of a coroutine event handler
+///
+/// The coroutine does not run until it is spawned (See `Coroutines::spawn()`), and its frame is released once it completes.
+///
+struct HandlerCoroutine
+{
+    struct promise_type;
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    /// `nullptr` if the frame pool is exhausted
+    Handle handle;
+
+    struct promise_type
+    {
+        __attribute__((always_inline))
+        static void* operator new(size_t size) noexcept;
+
+        static void operator delete(void* frame) noexcept;
+
+        static HandlerCoroutine get_return_object_on_allocation_failure()
+        {
+            return {nullptr};
+        }
+
+        HandlerCoroutine get_return_object()
+        {
+            return {Handle::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception() {}
+
+        ~promise_type();
+    };
+};
+
+namespace Coroutines
+{
+    /// The number of coroutines that may exist at the same time (i.e. the watering protocol only)
+    static constexpr size_t kCapacity = 1;
+
+    /// The maximum size of a coroutine frame
+    /// @note Optimized builds fail if the frame of a coroutine is larger (See `promise_type::operator new()`).
+    static constexpr size_t kFrameSize = 96;
+
+    /// The event whose handler resumes sleeping coroutines
+    static constexpr int kTimerEvent = UserEvent::kTimerEvent;
+
+    /// The number of events
+    static constexpr size_t kNumEvents = UserEvent::kNumUserEvents;
+
+    /// Type of a function that creates a coroutine
+    using Factory = HandlerCoroutine (*)();
+
+    struct Spawned
+    {
+        /// Creates the coroutine again if a step is aborted
+        Factory factory;
+
+        /// The event the coroutine waits for when it is spawned
+        int event;
+
+        /// `nullptr` if the coroutine has completed
+        std::coroutine_handle<> handle;
+    };
+
+    struct Sleeper
+    {
+        std::coroutine_handle<> handle;
+
+        /// Kernel uptime at which the coroutine wakes up
+        UInt32 wakeTime;
+    };
+
+    __attribute__((section(".userdata")))
+    inline CoroutineFramePool<kFrameSize, kCapacity> gFramePool;
+
+    /// The coroutine that waits for each event
+    __attribute__((section(".userdata")))
+    inline std::coroutine_handle<> gWaiters[kNumEvents];
+
+    /// Coroutines that wait for a timer
+    __attribute__((section(".userdata")))
+    inline Sleeper gSleepers[kCapacity];
+
+    /// Coroutines that have been spawned and have not completed yet
+    __attribute__((section(".userdata")))
+    inline Spawned gSpawned[kCapacity];
+
+    /// The coroutine whose step is running, or whose step has been aborted if a handler finds it set
+    __attribute__((section(".userdata")))
+    inline std::coroutine_handle<> gRunning;
+
+    ///
+    /// Let the given coroutine run once the given event is posted
+    ///
+    /// @param event Identifier of the event
+    /// @param factory A function that creates the coroutine, called again to respawn it if one of its steps is aborted
+    /// @return `true` on success, `false` if the frame pool has been exhausted or another coroutine waits for the event.
+    /// @note This function may be called by the kernel at boot, since it runs none of the coroutine.
+    ///
+    static inline bool spawn(int event, Factory factory)
+    {
+        if (gWaiters[event])
+        {
+            return false;
+        }
+
+        for (Spawned& spawned : gSpawned)
+        {
+            if (spawned.handle)
+            {
+                continue;
+            }
+
+            HandlerCoroutine coroutine = factory();
+
+            if (!coroutine.handle)
+            {
+                return false;
+            }
+
+            spawned = {factory, event, coroutine.handle};
+
+            gWaiters[event] = coroutine.handle;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    ///
+    /// Respawn the coroutine whose last step never returned
+    ///
+    /// @note The aborted step left its frame in an unknown state, so the frame is released without running any destructor.
+    ///
+    static inline void recover()
+    {
+        std::coroutine_handle<> aborted = gRunning;
+
+        if (!aborted)
+        {
+            return;
+        }
+
+        gRunning = nullptr;
+
+        for (std::coroutine_handle<>& waiter : gWaiters)
+        {
+            if (waiter == aborted)
+            {
+                waiter = nullptr;
+            }
+        }
+
+        for (Sleeper& sleeper : gSleepers)
+        {
+            if (sleeper.handle == aborted)
+            {
+                sleeper.handle = nullptr;
+            }
+        }
+
+        gFramePool.deallocate(aborted.address());
+
+        for (Spawned& spawned : gSpawned)
+        {
+            if (spawned.handle != aborted)
+            {
+                continue;
+            }
+
+            spawned.handle = nullptr;
+
+            sysprintf("Coroutines: A step waiting for event %d was aborted. Respawning the coroutine.\n", spawned.event);
+
+            if (!spawn(spawned.event, spawned.factory))
+            {
+                sysprintf("Coroutines: Failed to respawn the coroutine.\n");
+            }
+        }
+    }
+
+    ///
+    /// Run the next step of the given coroutine
+    ///
+    static inline void step(std::coroutine_handle<> handle)
+    {
+        gRunning = handle;
+
+        handle.resume();
+
+        gRunning = nullptr;
+    }
+
+    ///
+    /// Arm the kernel timer for the earliest sleeping coroutine
+    ///
+    static inline void armTimer(UInt32 now)
+    {
+        UInt32 delay = 0;
+
+        for (const Sleeper& sleeper : gSleepers)
+        {
+            if (!sleeper.handle)
+            {
+                continue;
+            }
+
+            // The timer posts the event after at least a millisecond
+            UInt32 remaining = static_cast<SInt32>(sleeper.wakeTime - now) > 0 ? sleeper.wakeTime - now : 1;
+
+            if (delay == 0 || remaining < delay)
+            {
+                delay = remaining;
+            }
+        }
+
+        sysSetTimer(kTimerEvent, delay);
+    }
+
+    ///
+    /// [Handler] Resume the coroutine that waits for the given event
+    ///
+    /// @tparam Identifier Identifier of the event
+    ///
+    template <int Identifier>
+    void resume()
+    {
+        recover();
+
+        std::coroutine_handle<> waiter = gWaiters[Identifier];
+
+        if (!waiter)
+        {
+            sysprintf("Coroutines: No coroutine waits for event %d.\n", Identifier);
+
+            return;
+        }
+
+        // The coroutine may wait for the same event again before it suspends
+        gWaiters[Identifier] = nullptr;
+
+        step(waiter);
+    }
+
+    ///
+    /// [Handler] Resume all coroutines whose timer has expired
+    ///
+    static inline void resumeSleepers()
+    {
+        recover();
+
+        UInt32 now = sysReadUptime();
+
+        for (Sleeper& sleeper : gSleepers)
+        {
+            if (sleeper.handle && static_cast<SInt32>(now - sleeper.wakeTime) >= 0)
+            {
+                std::coroutine_handle<> handle = sleeper.handle;
+
+                sleeper.handle = nullptr;
+
+                step(handle);
+            }
+        }
+
+        armTimer(sysReadUptime());
+    }
+
+    struct EventAwaiter
+    {
+        int event;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) const noexcept
+        {
+            gWaiters[this->event] = handle;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    struct TimerAwaiter
+    {
+        UInt32 milliseconds;
+
+        bool await_ready() const noexcept
+        {
+            return this->milliseconds == 0;
+        }
+
+        ///
+        /// Suspend the coroutine until the timer expires
+        ///
+        /// @return `true` if the coroutine sleeps, `false` if it continues right away since no sleeper slot is free.
+        ///
+        bool await_suspend(std::coroutine_handle<> handle) const noexcept
+        {
+            UInt32 now = sysReadUptime();
+
+            for (Sleeper& sleeper : gSleepers)
+            {
+                if (!sleeper.handle)
+                {
+                    sleeper = {handle, now + this->milliseconds};
+
+                    armTimer(now);
+
+                    return true;
+                }
+            }
+
+            sysprintf("Coroutines: No sleeper slot is free. Continuing without sleeping for %u ms.\n", this->milliseconds);
+
+            return false;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    ///
+    /// Suspend the coroutine until the given event is posted
+    ///
+    /// @param event Identifier of the event
+    /// @note Only one coroutine may wait for an event at a time.
+    ///
+    static inline EventAwaiter nextEvent(int event)
+    {
+        return {event};
+    }
+
+    ///
+    /// Suspend the coroutine for the given number of milliseconds
+    ///
+    /// @param milliseconds Number of milliseconds to sleep
+    ///
+    static inline TimerAwaiter sleepFor(UInt32 milliseconds)
+    {
+        return {milliseconds};
+    }
+}
+
+///
+/// Reports a coroutine whose frame does not fit in the frame pool
+///
+/// @note This function is never defined: The compiler rejects every call that optimizations cannot remove.
+///
+__attribute__((error("The coroutine frame is larger than `Coroutines::kFrameSize`.")))
+void CoroutineFrameTooLarge();
+
+inline void* HandlerCoroutine::promise_type::operator new(size_t size) noexcept
+{
+    // The compiler passes the frame size of the coroutine as a constant, which is only known once the coroutine is compiled,
+    // so a frame that is too large fails the (optimized) build rather than the allocation at run time.
+    if (__builtin_constant_p(size) && size > Coroutines::kFrameSize)
+    {
+        CoroutineFrameTooLarge();
+    }
+
+    return Coroutines::gFramePool.allocate(size);
+}
+
+inline void HandlerCoroutine::promise_type::operator delete(void* frame) noexcept
+{
+    Coroutines::gFramePool.deallocate(frame);
+}
+
+inline HandlerCoroutine::promise_type::~promise_type()
+{
+    // The coroutine has completed, so it is no longer respawned
+    std::coroutine_handle<> handle = Handle::from_promise(*this);
+
+    for (Coroutines::Spawned& spawned : Coroutines::gSpawned)
+    {
+        if (spawned.handle == handle)
+        {
+            spawned.handle = nullptr;
+        }
+    }
+}
+
+#endif /* HandlerCoroutine_hpp */
@@ -0,0 +1,98 @@
+//
+//  KernelEntry.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef KernelEntry_hpp
+#define KernelEntry_hpp
+
+#include <Types.hpp>
+#include <ARM/Context.hpp>
+#include "SupervisorCall.hpp"
+
+///
+/// Describes why the kernel has been entered
+///
+/// The kernel entry stub decodes the exception number (i.e. IPSR) and, for a system call,
+/// the immediate of the `svc` instruction once, and the record flows through the dispatcher as the service identifier.
+///
+/// @note System call numbers (< 14) and exception numbers of interrupts served by the kernel (>= 14) share the same space.
+///
+struct KernelEntry
+{
+    /// Exception number of a system call
+    static constexpr UInt8 kSupervisorCall = 11;
+
+    /// Exception number that entered the kernel (e.g. 11 for SVC, 14 for PendSV, 15 for SysTick)
+    UInt8 exception;
+
+    /// The system call number if the kernel is entered by a system call, the exception number otherwise
+    UInt8 identifier;
+
+    [[nodiscard]]
+    bool isSyscall() const
+    {
+        return this->exception == kSupervisorCall;
+    }
+
+    ///
+    /// Create the record of an interrupt claimed by the kernel while it idles
+    ///
+    /// @param vector The exception number of the interrupt
+    ///
+    static KernelEntry fromInterrupt(UInt32 vector)
+    {
+        return {static_cast<UInt8>(vector), static_cast<UInt8>(vector)};
+    }
+};
+
+static_assert(sizeof(KernelEntry) <= sizeof(UInt32), "The record must be passed in a single register.");
+
+///
+/// A component that reads system call arguments from the registers stacked on exception entry
+///
+/// The system call number is encoded in the `svc` instruction, so up to 4 arguments are passed in r0 - r3.
+/// The kernel writes the return value to the stacked r0.
+///
+/// @tparam Task Type of the task that derives from this component and `SharedStackSupport`
+///
+template <typename Task>
+struct SyscallRegisterArgumentSupport
+{
+    /// Index of the register that holds the next argument
+    UInt8 nextArgument = 0;
+
+    ///
+    /// Start reading the arguments of a new system call
+    ///
+    void resetSyscallArguments()
+    {
+        this->nextArgument = 0;
+    }
+
+    ///
+    /// Get the stacked r0 - r3 of the system call
+    ///
+    /// @note Pass the registers to `Syscall<Identifier>::unpack()` to read all arguments at once.
+    ///
+    const UInt32* getSyscallRegisters()
+    {
+        return &reinterpret_cast<const Context*>(static_cast<Task*>(this)->getStackPointer())->r0;
+    }
+
+    ///
+    /// Get the next argument of the system call
+    ///
+    /// @tparam T Type of the argument (at most 32 bits wide)
+    /// @return The value of the argument.
+    ///
+    template <typename T>
+    T getSyscallArgument()
+    {
+        return fromSyscallRegister<T>(this->getSyscallRegisters()[this->nextArgument++]);
+    }
+};
+
+#endif /* KernelEntry_hpp */
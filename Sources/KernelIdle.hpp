@@ -0,0 +1,74 @@
+//
+//  KernelIdle.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef KernelIdle_hpp
+#define KernelIdle_hpp
+
+#include <Types.hpp>
+#include "CMSIS/ARMCM3.h"
+
+///
+/// Idles the processor in the kernel when no event handler is ready to run
+///
+/// The kernel runs in handler mode with interrupts masked by PRIMASK.
+/// `wfi` would not wake up the processor, since it only wakes up for an exception that could preempt the active one,
+/// while the kernel runs in the SVC, SysTick or PendSV exception and all interrupts have the same priority as the latter two.
+/// Instead, `SEVONPEND` turns each interrupt that becomes pending into an event that wakes up `wfe` regardless of its priority.
+/// The kernel then claims the pending interrupt and serves it as if it had interrupted the idle handler,
+/// so that neither the exception entry nor the switch to and from the idle handler in thread mode is needed.
+///
+namespace KernelIdle
+{
+    ///
+    /// Let interrupts that become pending wake up the processor from `wfe`
+    ///
+    /// @note This function must be called before the kernel idles for the first time.
+    ///
+    static inline void setup()
+    {
+        SCB->SCR |= SCB_SCR_SEVONPEND_Msk;
+    }
+
+    ///
+    /// Sleep until an interrupt becomes pending and claim it
+    ///
+    /// @return The exception number of the pending interrupt (e.g. 14 for PendSV, 15 for SysTick).
+    /// @note The pending bit of a level-sensitive interrupt (e.g. UART) may be set again until the kernel clears the source,
+    ///       so the kernel may wake up once more to find nothing to do, which is harmless.
+    /// @note `wfe` returns at once if the event register has been set since the last `wfe` (e.g. by an interrupt that
+    ///       became pending after the check), so an interrupt is never missed, and a spurious wake-up only repeats the check.
+    ///
+    static inline UInt32 waitForInterrupt()
+    {
+        UInt32 vector;
+
+        while ((vector = (SCB->ICSR & SCB_ICSR_VECTPENDING_Msk) >> SCB_ICSR_VECTPENDING_Pos) == 0)
+        {
+            __DSB();
+
+            __WFE();
+        }
+
+        // Clear the pending status, so that the processor does not take the exception once interrupts are enabled
+        if (vector == 14)
+        {
+            SCB->ICSR = SCB_ICSR_PENDSVCLR_Msk;
+        }
+        else if (vector == 15)
+        {
+            SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+        }
+        else if (vector >= 16)
+        {
+            NVIC_ClearPendingIRQ(static_cast<IRQn_Type>(vector - 16));
+        }
+
+        return vector;
+    }
+}
+
+#endif /* KernelIdle_hpp */
@@ -0,0 +1,145 @@
+//
+//  Mailbox.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef Mailbox_hpp
+#define Mailbox_hpp
+
+#include <Types.hpp>
+#include <atomic>
+
+///
+/// A fixed-capacity single-producer single-consumer message queue that posts the event of its receiver
+///
+/// The producer reserves a slot, builds the message in place and commits it,
+/// while the consumer reads the message in place and releases the slot, so a message is never copied.
+/// Each side only writes its own index, so the queue needs no lock even if the producer is an interrupt handler.
+///
+/// Committing a message to an empty mailbox posts the receiver event through the notifier.
+/// The receiver must therefore drain the mailbox each time it runs, otherwise no further event is posted until it does,
+/// but a burst of messages posts the event only once.
+///
+/// @tparam Message Type of a message
+/// @tparam Capacity The number of slots (a power of two)
+/// @tparam Receiver Identifier of the event posted when a message arrives
+/// @tparam Notifier Type that provides `static void notify(int event)` to post the receiver event from the producer
+/// @note The processor has a single core, so compiler barriers are enough to order the message and the indices.
+///
+template <typename Message, size_t Capacity, int Receiver, typename Notifier>
+class Mailbox
+{
+    static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "The capacity must be a power of two.");
+
+    Message slots[Capacity];
+
+    /// Number of messages released so far (written by the consumer)
+    volatile UInt32 head;
+
+    /// Number of messages committed so far (written by the producer)
+    volatile UInt32 tail;
+
+public:
+    //
+    // MARK: Producer
+    //
+
+    ///
+    /// Reserve the slot of the next message
+    ///
+    /// @return The slot to build the message in, `nullptr` if the mailbox is full.
+    /// @note The slot is not visible to the consumer until the message is committed.
+    ///
+    Message* reserve()
+    {
+        if (this->tail - this->head == Capacity)
+        {
+            return nullptr;
+        }
+
+        return &this->slots[this->tail % Capacity];
+    }
+
+    ///
+    /// Commit the message built in the reserved slot and post the receiver event if the mailbox was empty
+    ///
+    void commit()
+    {
+        bool wasEmpty = this->tail == this->head;
+
+        std::atomic_signal_fence(std::memory_order_release);
+
+        this->tail = this->tail + 1;
+
+        if (wasEmpty)
+        {
+            Notifier::notify(Receiver);
+        }
+    }
+
+    ///
+    /// Send a copy of the given message
+    ///
+    /// @param message The message
+    /// @return `true` on success, `false` if the mailbox is full.
+    ///
+    bool send(const Message& message)
+    {
+        Message* slot = this->reserve();
+
+        if (slot == nullptr)
+        {
+            return false;
+        }
+
+        *slot = message;
+
+        this->commit();
+
+        return true;
+    }
+
+    //
+    // MARK: Consumer
+    //
+
+    ///
+    /// Get the oldest message
+    ///
+    /// @return The message, `nullptr` if the mailbox is empty.
+    /// @note The message stays valid until it is released.
+    ///
+    const Message* peek() const
+    {
+        if (this->head == this->tail)
+        {
+            return nullptr;
+        }
+
+        std::atomic_signal_fence(std::memory_order_acquire);
+
+        return &this->slots[this->head % Capacity];
+    }
+
+    ///
+    /// Release the slot of the oldest message
+    ///
+    void release()
+    {
+        std::atomic_signal_fence(std::memory_order_release);
+
+        this->head = this->head + 1;
+    }
+
+    ///
+    /// Discard all messages committed so far
+    ///
+    void clear()
+    {
+        this->head = this->tail;
+    }
+};
+
+#endif /* Mailbox_hpp */
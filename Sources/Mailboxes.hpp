@@ -0,0 +1,67 @@
+//
+//  Mailboxes.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef Mailboxes_hpp
+#define Mailboxes_hpp
+
+#include "Mailbox.hpp"
+#include "NativeInterrupt.hpp"
+#include "Syscall.hpp"
+#include "WireProtocol.hpp"
+#include "User.hpp"
+
+//
+// MARK: - Deployment: Mailboxes
+//
+// Messages between handlers are passed in mailboxes rather than shared globals:
+// - The UART1 native handler hands raw moisture readings over to the watering protocol (`gReadingMailbox`).
+// - The watering protocol hands the moisture level that triggers an alert over to the alert handlers.
+// - The kernel hands alerts that the actuator has never acknowledged over to the dropped alert handler.
+//
+// @note Event handlers run unprivileged, so mailboxes live in the shared user memory (See `MemoryProtection`).
+//
+
+///
+/// Posts the receiver event from a native interrupt handler
+///
+struct InterruptNotifier
+{
+    static void notify(int event)
+    {
+        NativeInterrupt::post(event);
+    }
+};
+
+///
+/// Posts the receiver event from an event handler
+///
+struct HandlerNotifier
+{
+    static void notify(int event)
+    {
+        sysSendEvent(event);
+    }
+};
+
+/// Raw moisture readings received by UART1
+__attribute__((section(".userdata")))
+inline Mailbox<WireProtocol::Reading, 4, kReadingEvent, InterruptNotifier> gReadingMailbox;
+
+/// Moisture levels that trigger a dry soil alert
+__attribute__((section(".userdata")))
+inline Mailbox<UInt32, 2, kDrySoilEvent, HandlerNotifier> gDrySoilMailbox;
+
+/// Moisture levels that trigger a wet soil alert
+__attribute__((section(".userdata")))
+inline Mailbox<UInt32, 2, kWetSoilEvent, HandlerNotifier> gWetSoilMailbox;
+
+/// Alerts whose delivery has been given up by the kernel
+/// The kernel posts the receiver event as a native handler does, since it cannot invoke a system call
+__attribute__((section(".userdata")))
+inline Mailbox<WireProtocol::Reading, 1, kAlertDroppedEvent, InterruptNotifier> gDroppedAlertMailbox;
+
+#endif /* Mailboxes_hpp */
@@ -14,7 +14,11 @@
 #include "EventHandlerTrampolineContextBuilder.hpp"
 #include "CMSIS/ARMCM3.h"
 #include "UART/PL011.hpp"
+#include "BootTrace.hpp"
+#include "MemoryProtection.hpp"
+#include "FaultHandler.hpp"
 #include "User.hpp"
+#include "HandlerCoroutine.hpp"
 
 //
 // Deployment: User stack shared by all event handlers
@@ -39,6 +43,7 @@ OSDeclareMemoryAllocatorWithKernelServiceRoutines(FreeListAllocator<ConstantAlig
 //
 // Deployment: Startup Routines
 //
+__attribute__((cold))
 static void initMemoryManager()
 {
     pinfo("Initializing the kernel memory allocator...");
@@ -50,6 +55,7 @@ static void initMemoryManager()
     passert(kMemoryAllocator.init(&sram, &eram - &sram), "Failed to configure the kernel memory allocator.");
 }
 
+__attribute__((cold))
 static void initInterruptTable()
 {
     pinfo("Initializing the kernel interrupt vector table...");
@@ -57,8 +63,27 @@ static void initInterruptTable()
     InterruptVectorTable::setup();
 
     InterruptVectorTable::registerHandler(11, InterruptVectorTable::AssemblyHandler(KernelEntryPoint));
+
+    // Native interrupt handlers enter the kernel through PendSV to post events
+    // It has the lowest priority, so that it runs once all native handlers have returned
+    InterruptVectorTable::registerHandler(NativeInterrupt::kPostVector, InterruptVectorTable::AssemblyHandler(KernelEntryPoint));
+
+    NVIC_SetPriority(PendSV_IRQn, 255);
+
+    // Capture a crash dump on any fault instead of running into a null vector entry
+    for (UInt32 vector = 3; vector <= 6; vector += 1)
+    {
+        InterruptVectorTable::registerHandler(vector, InterruptVectorTable::AssemblyHandler(FaultEntryPoint));
+    }
+
+    // Bus faults and usage faults would otherwise escalate to a hard fault and lose their own vector number
+    SCB->SHCSR |= SCB_SHCSR_BUSFAULTENA_Msk | SCB_SHCSR_USGFAULTENA_Msk;
+
+    // The kernel idles in handler mode, where no interrupt of the same priority wakes up `wfi`
+    KernelIdle::setup();
 }
 
+__attribute__((cold))
 static void initTimer()
 {
     // The processor runs at 50 MHz
@@ -70,6 +95,28 @@ static void initTimer()
     SysTick_Config(SYSTEM_CLOCK / 1000);
 }
 
+/// `true` if the watchdog timer has reset the system
+static bool resetByWatchdog = false;
+
+__attribute__((cold))
+static void initWatchdog()
+{
+    // The timer interrupt feeds the watchdog every millisecond (See `kSysTickInterruptHandler()`)
+    // The system resets if the kernel has not served the timer interrupt for 4 seconds,
+    // which leaves enough room for long kernel services that run with interrupts disabled (e.g. streaming the data log)
+    pinfo("Configuring the watchdog timer...");
+
+    resetByWatchdog = WatchdogTimer::checkAndClearReset();
+
+    if (resetByWatchdog)
+    {
+        pinfo("The system has been reset by the watchdog timer.");
+    }
+
+    WatchdogTimer::start(SYSTEM_CLOCK * 2);
+}
+
+__attribute__((cold))
 static void initUART1()
 {
     pinfo("Configuring UART1...");
@@ -93,11 +140,16 @@ static void initUART1()
     // IRQ number is 22 (See LM3S811 Manual)
     PL011::enableRxInterrupt(PL011::kUART1);
 
+    // Wire protocol frames have variable lengths, so we also need the RX timeout interrupt
+    // to drain the bytes that remain in the FIFO below the trigger level once the line goes idle.
+    PL011::enableRxTimeoutInterrupt(PL011::kUART1);
+
     NVIC_EnableIRQ(Interrupt6_IRQn);
 
     NVIC_SetPriority(Interrupt6_IRQn, 255);
 
-    InterruptVectorTable::registerHandler(22, InterruptVectorTable::AssemblyHandler(KernelEntryPoint));
+    // Draining the FIFO does not need the kernel, so the handler runs natively on top of the interrupted event handler
+    NativeInterrupt::registerHandler(22, KernelServiceRoutines::kUART1ReceiveNativeHandler);
 
     // By default, the hardware generates an interrupt once a byte is received
     // (i.e. The FIFO buffer can only hold a single byte)
@@ -111,36 +163,102 @@ static void initUART1()
     PL011::enableFIFO(PL011::kUART1);
 }
 
+__attribute__((cold))
+static void initDataLog()
+{
+    extern UInt32 __datalog_start, __datalog_end;
+
+    pinfo("Recovering the data log...");
+
+    if (!KernelServiceRoutines::kDataLog.init(reinterpret_cast<UInt32>(&__datalog_start), reinterpret_cast<UInt32>(&__datalog_end)))
+    {
+        pinfo("Failed to prepare the data log region.");
+
+        return;
+    }
+
+    KernelServiceRoutines::kDataLog.append(DataLogRecord::kBoot, 0, resetByWatchdog, 0);
+
+    KernelServiceRoutines::kDataLog.flush();
+}
+
+__attribute__((cold))
 static void initUserStack()
 {
-    // Allocate the shared user stack
-    pinfo("Allocating the shared user stack.");
+    // The shared user stack and user data are reserved at the top of RAM by the linker script
+    pinfo("Preparing the shared user stack.");
 
-    auto ustack = new UInt8[1024];
+    extern UInt8 gUserStackStart, gUserStackEnd, gUserDataStart, gUserDataEnd;
 
-    passert(ustack != nullptr, "Failed to allocate the shared user stack.");
+    // The bootloader neither loads nor clears user data
+    memset(&gUserDataStart, 0, &gUserDataEnd - &gUserDataStart);
+
+    auto ustack = &gUserStackStart;
 
     PL011::send(PL011::kUART1, Message::moistureUserStack(reinterpret_cast<UInt32>(ustack)));
 
-    gUserStackPointer = ustack + 1024;
+    gUserStackPointer = &gUserStackEnd;
 
     pinfo("Shared user stack at 0x%p.", ustack);
 
     pinfo("Initial user stack pointer at 0x%p.", gUserStackPointer);
 }
 
+__attribute__((cold))
+static void initMemoryProtection()
+{
+    pinfo("Configuring the memory protection unit...");
+
+    extern UInt8 gUserStackStart, gUserMemoryEnd;
+
+    // Violations in event handlers raise a memory management fault,
+    // while those in the kernel escalate to a hard fault since the kernel runs with interrupts disabled
+    // Both are captured by `FaultEntryPoint()` registered in `initInterruptTable()`
+    MemoryProtection::setup(&gUserStackStart, &gUserMemoryEnd - &gUserStackStart);
+}
+
+__attribute__((cold))
 static void initEvents()
 {
     // Preconfigure event handlers
     pinfo("Preconfigure event handlers.");
 
-    controller.registerEvent(kIdleEvent, idleHandler);
+    controller.registerEvent(kIdleEvent, idleHandler, kIdlePriority);
 
-    controller.registerEvent(kSensorEvent, readSensor);
+    // The periodic sensor reading, the timer and the raw reading resume coroutine handlers at the same priority,
+    // so that a coroutine is never resumed while it runs
+    controller.registerEvent(kSensorEvent, Coroutines::resume<kSensorEvent>, kReportPriority, kSensorDeadline, kSensorBudget);
 
-    controller.registerEvent(kDrySoilEvent, drySoilHandler);
+    controller.registerEvent(kTimerEvent, Coroutines::resumeSleepers, kReportPriority, kSensorDeadline, kSensorBudget);
 
-    controller.registerEvent(kWetSoilEvent, wetSoilHandler);
+    controller.registerEvent(kReadingEvent, Coroutines::resume<kReadingEvent>, kReportPriority, kSensorDeadline, kSensorBudget);
+
+    passert(Coroutines::spawn(kSensorEvent, wateringProtocol), "Failed to spawn the watering protocol.");
+
+    controller.registerEvent(kDrySoilEvent, drySoilHandler, kAlertPriority, kAlertDeadline, kAlertBudget);
+
+    controller.registerEvent(kWetSoilEvent, wetSoilHandler, kAlertPriority, kAlertDeadline, kAlertBudget);
+
+    controller.registerEvent(kAlertDroppedEvent, alertDroppedHandler, kAlertPriority, kAlertDeadline, kAlertBudget);
+
+    // The watering protocol reacts to a moisture change right away rather than at the next periodic reading
+    passert(controller.subscribe(Message::Type::kChangeSoilMoisture, kSensorEvent), "Failed to subscribe to moisture changes.");
+
+    // Bound the posts that wait for busy handlers
+    // A late periodic reading is worth as much as several ones, while only the latest alerts matter
+    using OverflowPolicy = decltype(KernelServiceRoutines::kPendingEvents)::OverflowPolicy;
+
+    KernelServiceRoutines::kPendingEvents.setOverflowPolicy(kSensorEvent, OverflowPolicy::kCoalesce);
+
+    KernelServiceRoutines::kPendingEvents.setOverflowPolicy(kTimerEvent, OverflowPolicy::kCoalesce);
+
+    KernelServiceRoutines::kPendingEvents.setOverflowPolicy(kReadingEvent, OverflowPolicy::kCoalesce);
+
+    KernelServiceRoutines::kPendingEvents.setOverflowPolicy(kDrySoilEvent, OverflowPolicy::kDropOldest);
+
+    KernelServiceRoutines::kPendingEvents.setOverflowPolicy(kWetSoilEvent, OverflowPolicy::kDropOldest);
+
+    KernelServiceRoutines::kPendingEvents.setOverflowPolicy(kAlertDroppedEvent, OverflowPolicy::kCoalesce);
 }
 
 //
@@ -148,6 +266,8 @@ static void initEvents()
 //
 extern "C" void kmain(void)
 {
+    BootTrace::record(BootTrace::kKernelMain);
+
     pinfo("Kernel main function started.");
 
     kprintf("~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n");
@@ -157,30 +277,63 @@ extern "C" void kmain(void)
     // Configure the kernel memory allocator
     initMemoryManager();
 
+    BootTrace::record(BootTrace::kMemoryManager);
+
     // Configure the kernel interrupt table
     initInterruptTable();
 
+    BootTrace::record(BootTrace::kInterruptTable);
+
     // Configure the timer
 #ifndef RUN_STACK_EXP
     initTimer();
+
+    BootTrace::record(BootTrace::kTimer);
+
+    // Reset the system if the kernel stops serving the timer
+    initWatchdog();
+
+    BootTrace::record(BootTrace::kWatchdog);
 #endif
 
     // Configure UART1 and RX interrupts
     initUART1();
 
+    BootTrace::record(BootTrace::kUART1);
+
     // Allocate shared stack for event handlers
     initUserStack();
 
+    BootTrace::record(BootTrace::kUserStack);
+
+    // Isolate event handlers from the kernel
+    initMemoryProtection();
+
+    BootTrace::record(BootTrace::kMemoryProtection);
+
     // Setup events and handlers
     initEvents();
 
+    BootTrace::record(BootTrace::kEvents);
+
+    // Recover the sensor history from the flash
+    initDataLog();
+
+    BootTrace::record(BootTrace::kDataLog);
+
+    // Report the crash dump captured before the last reset, if any
+    reportCrashDump();
+
     // Dispatcher
     // We assume that the idle handler was running before we first enter the dispatcher
     // We need to set up the execution context for the idle handler
+    // The kernel never switches to it, but event handlers are created on top of its context on the shared stack
     pinfo("Initialize the idle event handler.");
 
     EventHandlerTrampolineContextBuilder_ARM{}(nullptr, controller.getRegisteredEvent(0));
 
+    BootTrace::record(BootTrace::kIdleContext);
+
     pinfo("Enter the dispatcher.");
 
     EventDispatcher dispatcher(controller.getRegisteredEvent(0), controller.getRegisteredEvent(1));
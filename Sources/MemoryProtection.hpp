@@ -0,0 +1,244 @@
+//
+//  MemoryProtection.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef MemoryProtection_hpp
+#define MemoryProtection_hpp
+
+#include <Types.hpp>
+#include <cstddef>
+#include "CMSIS/ARMCM3.h"
+
+// Bounds of the shared user memory (See `Kernel.ld`)
+extern UInt8 gUserStackStart, gUserMemoryEnd;
+
+///
+/// Isolates event handlers from the kernel with the memory protection unit
+///
+/// Event handlers run unprivileged in thread mode and may only access the flash (read-only) and the shared user memory,
+/// which holds the shared user stack and user data (e.g. coroutine frames) at its top.
+/// The rest of the SRAM (i.e. kernel data, kernel stack and kernel heap) is accessible only in privileged mode.
+/// A guard region right below the user memory is inaccessible in both modes,
+/// so that a handler overflowing the stack faults instead of corrupting the kernel heap.
+///
+/// | Region | Memory      | Privileged | Unprivileged | Executable |
+/// |--------|-------------|------------|--------------|------------|
+/// | 0      | Flash       | RO         | RO           | Yes        |
+/// | 1      | SRAM        | RW         | None         | Yes        |
+/// | 2      | User Memory | RW         | RW           | No         |
+/// | 3      | Stack Guard | None       | None         | No         |
+///
+/// Regions with a higher number take priority, and the default memory map applies to privileged accesses elsewhere (e.g. peripherals).
+///
+/// @note The size of an MPU region must be a power of two of at least 32 bytes, and its base address must be aligned to its size.
+///
+namespace MemoryProtection
+{
+    namespace Regions
+    {
+        static constexpr UInt32 kFlash = 0;
+
+        static constexpr UInt32 kSRAM = 1;
+
+        static constexpr UInt32 kUserStack = 2;
+
+        static constexpr UInt32 kStackGuard = 3;
+    }
+
+    /// Size of the guard region below the user stack
+    static constexpr UInt32 kStackGuardSize = 32;
+
+    /// Size of the flash, which event handlers may read
+    static constexpr UInt32 kFlashSize = 0x10000;
+
+    ///
+    /// Get the encoded size of an MPU region
+    ///
+    /// @param size Size of the region in bytes (a power of two of at least 32 bytes)
+    /// @return The value of the SIZE field in the region attribute and size register.
+    ///
+    static constexpr UInt32 encodeSize(UInt32 size)
+    {
+        UInt32 exponent = 0;
+
+        while ((1U << (exponent + 1)) < size)
+        {
+            exponent += 1;
+        }
+
+        return exponent;
+    }
+
+    ///
+    /// Configure and enable the memory protection unit
+    ///
+    /// @param stack Start address of the shared user memory (i.e. the lowest address the user stack may reach)
+    /// @param size Size of the shared user memory in bytes
+    /// @note The guard region occupies the `kStackGuardSize` bytes below the user memory.
+    /// @note This function must be called in handler mode before the kernel runs the first event handler.
+    ///
+    static inline void setup(const UInt8* stack, UInt32 size)
+    {
+        UInt32 base = reinterpret_cast<UInt32>(stack);
+
+        ARM_MPU_Disable();
+
+        // Normal memory attributes: Flash is cacheable, SRAM is cacheable and shareable
+        ARM_MPU_SetRegion(ARM_MPU_RBAR(Regions::kFlash, 0x00000000),
+                          ARM_MPU_RASR(0, ARM_MPU_AP_RO, 0, 0, 1, 0, 0, ARM_MPU_REGION_SIZE_64KB));
+
+        // Hot kernel functions run from the SRAM, so the region must be executable
+        ARM_MPU_SetRegion(ARM_MPU_RBAR(Regions::kSRAM, 0x20000000),
+                          ARM_MPU_RASR(0, ARM_MPU_AP_PRIV, 0, 1, 1, 0, 0, ARM_MPU_REGION_SIZE_8KB));
+
+        ARM_MPU_SetRegion(ARM_MPU_RBAR(Regions::kUserStack, base),
+                          ARM_MPU_RASR(1, ARM_MPU_AP_FULL, 0, 1, 1, 0, 0, encodeSize(size)));
+
+        ARM_MPU_SetRegion(ARM_MPU_RBAR(Regions::kStackGuard, base - kStackGuardSize),
+                          ARM_MPU_RASR(1, ARM_MPU_AP_NONE, 0, 1, 1, 0, 0, encodeSize(kStackGuardSize)));
+
+        // Also enables the memory management fault
+        ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk);
+
+        // Event handlers run unprivileged from now on
+        // The kernel is not affected, since it always runs in handler mode
+        __set_CONTROL(__get_CONTROL() | CONTROL_nPRIV_Msk);
+
+        __ISB();
+    }
+
+    ///
+    /// Check whether the given address falls in the guard region below the user stack
+    ///
+    /// @param address The faulting address
+    /// @param stack Start address of the shared user stack
+    /// @return `true` if the address is in the guard region, `false` otherwise.
+    ///
+    static inline bool isStackGuard(UInt32 address, const UInt8* stack)
+    {
+        UInt32 base = reinterpret_cast<UInt32>(stack);
+
+        return address >= base - kStackGuardSize && address < base;
+    }
+
+    ///
+    /// Check whether the given range lies in the given region
+    ///
+    static inline bool isInRegion(UInt32 start, UInt32 end, UInt32 address, size_t size)
+    {
+        return address >= start && address <= end && size <= end - address;
+    }
+
+    ///
+    /// Checks memory passed by event handlers to the kernel against the regions event handlers may access
+    ///
+    /// The kernel runs privileged, so it must not read or write on behalf of an event handler
+    /// any memory that the handler could not access itself (e.g. kernel data).
+    ///
+    struct UserAccess
+    {
+        ///
+        /// Check whether event handlers may write the given range (i.e. the shared user memory)
+        ///
+        static inline bool canWrite(const void* address, size_t size)
+        {
+            return isInRegion(reinterpret_cast<UInt32>(&gUserStackStart), reinterpret_cast<UInt32>(&gUserMemoryEnd),
+                              reinterpret_cast<UInt32>(address), size);
+        }
+
+        ///
+        /// Check whether event handlers may read the given range (i.e. the flash or the shared user memory)
+        ///
+        static inline bool canRead(const void* address, size_t size)
+        {
+            return isInRegion(0, kFlashSize, reinterpret_cast<UInt32>(address), size) || canWrite(address, size);
+        }
+
+        ///
+        /// Check whether event handlers may read the given string up to and including its terminator
+        ///
+        static inline bool canReadString(const char* string)
+        {
+            for (const char* character = string; canRead(character, 1); character += 1)
+            {
+                if (*character == '\0')
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        ///
+        /// Check whether event handlers may print the given values with the given format string
+        ///
+        /// @param format A format string that event handlers may read
+        /// @param values Values consumed by the conversions in order
+        /// @param count Number of values
+        /// @param violation Set to the first string that event handlers may not read,
+        ///                  or to the format string if it consumes more than `count` values.
+        /// @return `true` if every `%s` conversion refers to a string that event handlers may read, `false` otherwise.
+        ///
+        static inline bool canPrint(const char* format, const UInt32* values, size_t count, const void*& violation)
+        {
+            size_t index = 0;
+
+            for (const char* character = format; *character != '\0'; character += 1)
+            {
+                if (*character != '%')
+                {
+                    continue;
+                }
+
+                // Skip flags, the width, the precision and length modifiers up to the conversion specifier
+                character += 1;
+
+                while (*character != '\0' && (*character < 'a' || *character > 'z' || *character == 'l' || *character == 'h') &&
+                       (*character < 'A' || *character > 'Z') && *character != '%')
+                {
+                    // A width or precision read from the values consumes one of them
+                    if (*character == '*')
+                    {
+                        index += 1;
+                    }
+
+                    character += 1;
+                }
+
+                if (*character == '\0')
+                {
+                    break;
+                }
+
+                if (*character == '%')
+                {
+                    continue;
+                }
+
+                if (index >= count)
+                {
+                    violation = format;
+
+                    return false;
+                }
+
+                if (*character == 's' && !canReadString(reinterpret_cast<const char*>(values[index])))
+                {
+                    violation = reinterpret_cast<const void*>(values[index]);
+
+                    return false;
+                }
+
+                index += 1;
+            }
+
+            return true;
+        }
+    };
+}
+
+#endif /* MemoryProtection_hpp */
@@ -36,10 +36,15 @@ struct Message
         kSoilWetAlert = 6,
 
         /// Used by the actuator device (Gate Actuator)
+        /// Acknowledges a soil wet alert sent in a wire protocol frame; the value is the sequence number of the alert
         kAckSoilWet = 7,
 
         /// Used by the actuator device (Water Level Sensor)
         kRunOutOfWaterAlert = 8,
+
+        /// Used by the actuator device (Gate Actuator)
+        /// Acknowledges an alert of any type sent in a wire protocol frame; the value is the sequence number of the alert
+        kAckAlert = 9,
     };
     
     static inline const char* Type2String(Type type)
@@ -72,6 +77,12 @@ struct Message
                 
             case kRunOutOfWaterAlert:
                 return "No Water Alert";
+
+            case kAckAlert:
+                return "Ack Alert";
+
+            default:
+                return "Unknown";
         }
     }
 
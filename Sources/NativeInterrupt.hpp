@@ -0,0 +1,156 @@
+//
+//  NativeInterrupt.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef NativeInterrupt_hpp
+#define NativeInterrupt_hpp
+
+#include <Types.hpp>
+#include "ARM/v7-M/InterruptVectorTable.hpp"
+#include "CMSIS/ARMCM3.h"
+#include "CpuAccounting.hpp"
+
+///
+/// Lightweight interrupt handlers that run in handler mode without entering the kernel
+///
+/// A native handler is installed in the vector table (behind `entry()`), so the processor runs it on the main stack on top of
+/// the event handler it interrupts: The user context is not saved, and neither the dispatcher nor the scheduler runs.
+/// A native handler that needs an event handler to run posts the event instead,
+/// and the kernel is entered through `KernelEntryPoint` once the native handler returns (i.e. via PendSV) to release it.
+///
+/// When the kernel idles, it serves native interrupts in place and keeps sleeping until an event is posted.
+/// In both cases, the time spent in a native handler is accounted to interrupts (See `CpuAccounting`).
+///
+/// @note Native handlers never run concurrently with the kernel, since the kernel runs with interrupts disabled,
+///       and native handlers must have the same priority as the exceptions that enter the kernel (i.e. SysTick and PendSV).
+///
+namespace NativeInterrupt
+{
+    using Handler = void (*)();
+
+    /// The maximum number of native handlers
+    static constexpr size_t kCapacity = 4;
+
+    /// Exception number of PendSV, through which native handlers enter the kernel to post events
+    static constexpr UInt32 kPostVector = 14;
+
+    struct Entry
+    {
+        UInt32 vector;
+
+        Handler handler;
+    };
+
+    inline Entry gEntries[kCapacity];
+
+    inline size_t gNumEntries;
+
+    /// Events posted by native handlers that the kernel has not released yet (one bit per event)
+    inline UInt32 gPostedEvents;
+
+    ///
+    /// Serve the given interrupt in place if it has a native handler
+    ///
+    /// @param vector The exception number of the interrupt
+    /// @return `true` if the native handler has served the interrupt, `false` if the kernel must serve it.
+    /// @note This function is called by the kernel when it idles and by `entry()` when a native interrupt arrives.
+    ///
+    static inline bool serve(UInt32 vector)
+    {
+        for (size_t index = 0; index < gNumEntries; index += 1)
+        {
+            if (gEntries[index].vector == vector)
+            {
+                UInt32 start = CpuAccounting::onNativeInterruptEntry();
+
+                gEntries[index].handler();
+
+                CpuAccounting::onNativeInterruptExit(start);
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    ///
+    /// The handler installed in the vector table for every native interrupt
+    ///
+    /// @note The active exception number is read from IPSR to find the native handler.
+    ///
+    static inline void entry()
+    {
+        serve(__get_IPSR());
+    }
+
+    ///
+    /// Install a native handler for the given interrupt
+    ///
+    /// @param vector The exception number (e.g. 22 for UART1)
+    /// @param handler The native handler
+    /// @return `true` on success, `false` if there are too many native handlers.
+    ///
+    static inline bool registerHandler(UInt32 vector, Handler handler)
+    {
+        if (gNumEntries == kCapacity)
+        {
+            return false;
+        }
+
+        gEntries[gNumEntries++] = {vector, handler};
+
+        InterruptVectorTable::registerHandler(vector, InterruptVectorTable::AssemblyHandler(&entry));
+
+        return true;
+    }
+
+    ///
+    /// Post all given events from a native handler
+    ///
+    /// @param events A bit mask of events
+    /// @note The kernel releases the handlers of all events at once, so they run in priority order.
+    ///
+    static inline void postAll(UInt32 events)
+    {
+        if (events == 0)
+        {
+            return;
+        }
+
+        gPostedEvents |= events;
+
+        SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+    }
+
+    ///
+    /// Post the given event from a native handler
+    ///
+    /// @param event Identifier of the event (< 32)
+    /// @note The kernel releases the handler of the event once all pending native handlers have returned.
+    ///
+    static inline void post(UInt32 event)
+    {
+        postAll(1U << event);
+    }
+
+    ///
+    /// Take all events posted by native handlers
+    ///
+    /// @return A bit mask of posted events.
+    /// @note This function is called by the kernel.
+    ///
+    static inline UInt32 takePostedEvents()
+    {
+        UInt32 events = gPostedEvents;
+
+        gPostedEvents = 0;
+
+        return events;
+    }
+}
+
+#endif /* NativeInterrupt_hpp */
@@ -0,0 +1,234 @@
+//
+//  PendingEventQueue.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef PendingEventQueue_hpp
+#define PendingEventQueue_hpp
+
+#include <Types.hpp>
+
+/// Back-pressure statistics of an event
+struct EventStatistics
+{
+    /// Number of times the event has been posted
+    UInt32 posted;
+
+    /// Number of posts discarded because the backlog was full
+    UInt32 dropped;
+
+    /// Number of posts merged into one that was already in the backlog
+    UInt32 coalesced;
+
+    /// Maximum number of outstanding posts (i.e. the one being handled and those in the backlog)
+    UInt32 maxDepth;
+};
+
+///
+/// Bounds the number of posted events that wait for their handlers
+///
+/// Each event has a single control block, so it cannot be handed to the scheduler again until its handler completes.
+/// Posts of an event whose handler is pending or running wait in a bounded backlog shared by all events,
+/// and are handed to the scheduler in order once the handler completes.
+/// If the backlog is full or the event is already in the backlog, the overflow policy of the event decides what happens.
+///
+/// @tparam NumEvents The number of events
+/// @tparam Capacity The maximum number of posts in the backlog
+/// @note All functions must be called with interrupts disabled (i.e. in the kernel).
+///
+template <size_t NumEvents, size_t Capacity>
+class PendingEventQueue
+{
+public:
+    enum class OverflowPolicy : UInt8
+    {
+        /// Discard the new post if the backlog is full
+        kDropNewest,
+
+        /// Replace the post of the same event in the backlog with the new one, or discard the new post if the backlog is full
+        kDropOldest,
+
+        /// Merge the new post into the one in the backlog, or discard it if the backlog is full
+        kCoalesce,
+    };
+
+private:
+    /// `true` if the handler of the event has been handed to the scheduler and has not completed yet
+    bool busy[NumEvents] = {};
+
+    /// Overflow policy of each event
+    OverflowPolicy policies[NumEvents] = {};
+
+    /// Statistics of each event
+    EventStatistics statistics[NumEvents] = {};
+
+    /// Number of posts of each event in the backlog
+    size_t backlogged[NumEvents] = {};
+
+    /// Posts waiting for their handlers in chronological order
+    size_t backlog[Capacity] = {};
+
+    /// Number of posts in the backlog
+    size_t count = 0;
+
+    size_t find(size_t event) const
+    {
+        for (size_t index = 0; index < this->count; index += 1)
+        {
+            if (this->backlog[index] == event)
+            {
+                return index;
+            }
+        }
+
+        return Capacity;
+    }
+
+    void remove(size_t index)
+    {
+        this->backlogged[this->backlog[index]] -= 1;
+
+        for (size_t next = index + 1; next < this->count; next += 1)
+        {
+            this->backlog[next - 1] = this->backlog[next];
+        }
+
+        this->count -= 1;
+    }
+
+    void append(size_t event)
+    {
+        this->backlog[this->count] = event;
+
+        this->count += 1;
+
+        this->backlogged[event] += 1;
+
+        EventStatistics& stats = this->statistics[event];
+
+        if (this->backlogged[event] + 1 > stats.maxDepth)
+        {
+            stats.maxDepth = this->backlogged[event] + 1;
+        }
+    }
+
+public:
+    ///
+    /// Set the overflow policy of the given event
+    ///
+    /// @param event Identifier of the event
+    /// @param policy The overflow policy
+    ///
+    void setOverflowPolicy(size_t event, OverflowPolicy policy)
+    {
+        if (event < NumEvents)
+        {
+            this->policies[event] = policy;
+        }
+    }
+
+    ///
+    /// Post the given event
+    ///
+    /// @param event Identifier of the event
+    /// @return `true` if the handler of the event should be handed to the scheduler now,
+    ///         `false` if the post is deferred, merged or discarded.
+    ///
+    bool post(size_t event)
+    {
+        if (event >= NumEvents)
+        {
+            return false;
+        }
+
+        EventStatistics& stats = this->statistics[event];
+
+        stats.posted += 1;
+
+        if (!this->busy[event])
+        {
+            this->busy[event] = true;
+
+            if (stats.maxDepth == 0)
+            {
+                stats.maxDepth = 1;
+            }
+
+            return true;
+        }
+
+        OverflowPolicy policy = this->policies[event];
+
+        if (this->backlogged[event] != 0)
+        {
+            if (policy == OverflowPolicy::kCoalesce)
+            {
+                stats.coalesced += 1;
+
+                return false;
+            }
+
+            if (policy == OverflowPolicy::kDropOldest)
+            {
+                // Only the latest post of the event waits, so posts of other events are never evicted
+                stats.dropped += 1;
+
+                this->remove(this->find(event));
+            }
+        }
+
+        if (this->count == Capacity)
+        {
+            stats.dropped += 1;
+
+            return false;
+        }
+
+        this->append(event);
+
+        return false;
+    }
+
+    ///
+    /// Invoked when the handler of the given event completes
+    ///
+    /// @param event Identifier of the event
+    /// @return `true` if the handler should be handed to the scheduler again for a post in the backlog, `false` otherwise.
+    ///
+    bool complete(size_t event)
+    {
+        if (event >= NumEvents)
+        {
+            return false;
+        }
+
+        size_t index = this->find(event);
+
+        if (index != Capacity)
+        {
+            this->remove(index);
+
+            return true;
+        }
+
+        this->busy[event] = false;
+
+        return false;
+    }
+
+    ///
+    /// Get the statistics of the given event
+    ///
+    /// @param event Identifier of the event
+    /// @return A non-null pointer to the statistics on success, `nullptr` if the event identifier is invalid.
+    ///
+    [[nodiscard]]
+    const EventStatistics* getStatistics(size_t event) const
+    {
+        return event < NumEvents ? &this->statistics[event] : nullptr;
+    }
+};
+
+#endif /* PendingEventQueue_hpp */
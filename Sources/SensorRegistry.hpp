@@ -0,0 +1,169 @@
+//
+//  SensorRegistry.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef SensorRegistry_hpp
+#define SensorRegistry_hpp
+
+#include <Types.hpp>
+#include "SensorStatistics.hpp"
+
+/// A timestamped sensor sample
+struct Sample
+{
+    /// Kernel uptime in milliseconds when the sample was received
+    UInt32 timestamp;
+
+    /// Value reported by the sensor
+    UInt32 value;
+};
+
+///
+/// A registry of sensors, each of which keeps its most recent samples in a ring buffer
+///
+/// @tparam NumSensors The number of sensors
+/// @tparam Depth The number of samples kept per sensor, which is also the window of the minimum and maximum
+/// @note Streaming statistics of each sensor are updated as samples are recorded (See `StreamingStatistics`).
+/// @note All functions must be called with interrupts disabled (i.e. in the kernel).
+///
+template <size_t NumSensors, size_t Depth>
+class SensorRegistry
+{
+    struct RingBuffer
+    {
+        /// Samples in chronological order starting at `head`
+        Sample samples[Depth];
+
+        /// Index of the oldest sample
+        size_t head;
+
+        /// Number of valid samples
+        size_t count;
+
+        /// Statistics of all samples
+        StreamingStatistics<Depth> statistics;
+    };
+
+    RingBuffer sensors[NumSensors] = {};
+
+public:
+    ///
+    /// Check whether the given sensor identifier is valid
+    ///
+    /// @param sensor Identifier of the sensor
+    /// @return `true` if the sensor is registered, `false` otherwise.
+    ///
+    [[nodiscard]]
+    static constexpr bool isValid(size_t sensor)
+    {
+        return sensor < NumSensors;
+    }
+
+    ///
+    /// Record a new sample and overwrite the oldest one if the buffer is full
+    ///
+    /// @param sensor Identifier of the sensor
+    /// @param timestamp Kernel uptime in milliseconds
+    /// @param value Value reported by the sensor
+    /// @return `true` on success, `false` if the sensor identifier is invalid.
+    ///
+    bool record(size_t sensor, UInt32 timestamp, UInt32 value)
+    {
+        if (!isValid(sensor))
+        {
+            return false;
+        }
+
+        RingBuffer& buffer = this->sensors[sensor];
+
+        if (buffer.count < Depth)
+        {
+            buffer.samples[(buffer.head + buffer.count) % Depth] = {timestamp, value};
+
+            buffer.count += 1;
+        }
+        else
+        {
+            buffer.samples[buffer.head] = {timestamp, value};
+
+            buffer.head = (buffer.head + 1) % Depth;
+        }
+
+        buffer.statistics.update(timestamp, value);
+
+        return true;
+    }
+
+    ///
+    /// Get the streaming statistics of the given sensor
+    ///
+    /// @param sensor Identifier of the sensor
+    /// @return A non-null pointer to the statistics on success, `nullptr` if the sensor identifier is invalid or no sample has been received.
+    ///
+    [[nodiscard]]
+    const SensorStatistics* getStatistics(size_t sensor) const
+    {
+        if (!isValid(sensor) || this->sensors[sensor].count == 0)
+        {
+            return nullptr;
+        }
+
+        return &this->sensors[sensor].statistics.getStatistics();
+    }
+
+    ///
+    /// Get the most recent sample of the given sensor
+    ///
+    /// @param sensor Identifier of the sensor
+    /// @return A non-null sample on success, `nullptr` if the sensor identifier is invalid or no sample has been received.
+    ///
+    [[nodiscard]]
+    const Sample* getLatestSample(size_t sensor) const
+    {
+        if (!isValid(sensor) || this->sensors[sensor].count == 0)
+        {
+            return nullptr;
+        }
+
+        const RingBuffer& buffer = this->sensors[sensor];
+
+        return &buffer.samples[(buffer.head + buffer.count - 1) % Depth];
+    }
+
+    ///
+    /// Copy the most recent samples of the given sensor in chronological order
+    ///
+    /// @param sensor Identifier of the sensor
+    /// @param output A buffer that stores at least `count` samples
+    /// @param count The maximum number of samples to copy
+    /// @return The number of samples copied.
+    ///
+    size_t copySamples(size_t sensor, Sample* output, size_t count) const
+    {
+        if (!isValid(sensor))
+        {
+            return 0;
+        }
+
+        const RingBuffer& buffer = this->sensors[sensor];
+
+        if (count > buffer.count)
+        {
+            count = buffer.count;
+        }
+
+        size_t start = buffer.head + buffer.count - count;
+
+        for (size_t index = 0; index < count; index += 1)
+        {
+            output[index] = buffer.samples[(start + index) % Depth];
+        }
+
+        return count;
+    }
+};
+
+#endif /* SensorRegistry_hpp */
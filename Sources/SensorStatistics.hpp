@@ -0,0 +1,189 @@
+//
+//  SensorStatistics.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef SensorStatistics_hpp
+#define SensorStatistics_hpp
+
+#include <Types.hpp>
+#include <cstdint>
+
+///
+/// Streaming statistics of a sensor
+///
+/// @note Fractional values use 8 fractional bits, i.e. the real value is `field / 256`.
+///
+struct SensorStatistics
+{
+    /// Number of samples since the sensor started reporting
+    UInt32 count;
+
+    /// Exponential moving average of the value (8 fractional bits)
+    UInt32 average;
+
+    /// Minimum value in the window
+    UInt32 minimum;
+
+    /// Maximum value in the window
+    UInt32 maximum;
+
+    /// Smoothed rate of change of the value per second (8 fractional bits)
+    SInt32 slope;
+};
+
+///
+/// Maintains the statistics of a sensor incrementally in O(1) (amortized) per sample
+///
+/// - The average is an exponential moving average with a smoothing factor of `2^-Shift`.
+/// - The minimum and maximum are computed over the last `Window` samples with monotonic wedges.
+/// - The slope is an exponential moving average of the rate of change between two consecutive samples.
+///
+/// @tparam Window The number of samples in the min/max window
+/// @tparam Shift The smoothing factor of moving averages is `2^-Shift`
+///
+template <size_t Window, UInt32 Shift = 3>
+class StreamingStatistics
+{
+    static constexpr UInt32 kFractionalBits = 8;
+
+    /// The largest value whose fixed-point representation fits in the average
+    static constexpr UInt32 kMaxAverageValue = UINT32_MAX >> kFractionalBits;
+
+    /// A monotonic wedge that keeps candidates of the minimum (or maximum) of the window
+    /// Each element is pushed and popped at most once, so updates are O(1) amortized.
+    template <typename Comparator>
+    struct Wedge
+    {
+        struct Entry
+        {
+            UInt32 index;
+
+            UInt32 value;
+        };
+
+        Entry entries[Window];
+
+        size_t head;
+
+        size_t count;
+
+        void push(UInt32 index, UInt32 value)
+        {
+            // Evict the candidate that falls out of the window
+            if (this->count != 0 && index - this->entries[this->head].index >= Window)
+            {
+                this->head = (this->head + 1) % Window;
+
+                this->count -= 1;
+            }
+
+            // Evict candidates that can never be the extremum again
+            while (this->count != 0 && !Comparator{}(this->entries[(this->head + this->count - 1) % Window].value, value))
+            {
+                this->count -= 1;
+            }
+
+            this->entries[(this->head + this->count) % Window] = {index, value};
+
+            this->count += 1;
+        }
+
+        [[nodiscard]]
+        UInt32 front() const
+        {
+            return this->entries[this->head].value;
+        }
+    };
+
+    struct Less
+    {
+        bool operator()(UInt32 lhs, UInt32 rhs) const { return lhs < rhs; }
+    };
+
+    struct Greater
+    {
+        bool operator()(UInt32 lhs, UInt32 rhs) const { return lhs > rhs; }
+    };
+
+    Wedge<Less> minimums = {};
+
+    Wedge<Greater> maximums = {};
+
+    SensorStatistics statistics = {};
+
+    UInt32 lastTimestamp = 0;
+
+    UInt32 lastValue = 0;
+
+public:
+    ///
+    /// Update the statistics with a new sample
+    ///
+    /// @param timestamp Timestamp of the sample in milliseconds
+    /// @param value Value of the sample
+    ///
+    void update(UInt32 timestamp, UInt32 value)
+    {
+        SensorStatistics& stats = this->statistics;
+
+        // Fixed-point arithmetic is done in 64 bits, and the average saturates at the largest value it can represent
+        SInt64 scaled = static_cast<SInt64>(value < kMaxAverageValue ? value : kMaxAverageValue) << kFractionalBits;
+
+        if (stats.count == 0)
+        {
+            stats.average = static_cast<UInt32>(scaled);
+
+            stats.slope = 0;
+        }
+        else
+        {
+            // The new average lies between the old one and the scaled value, so it fits in 32 bits
+            stats.average = static_cast<UInt32>(stats.average + ((scaled - stats.average) >> Shift));
+
+            // Samples received within the same millisecond do not contribute to the slope
+            UInt32 elapsed = timestamp - this->lastTimestamp;
+
+            if (elapsed != 0)
+            {
+                SInt64 delta = static_cast<SInt64>(value) - static_cast<SInt64>(this->lastValue);
+
+                SInt64 rate = delta * (1000 << kFractionalBits) / elapsed;
+
+                // Saturate the rate, so that the smoothed slope stays within 32 bits
+                rate = rate > INT32_MAX ? INT32_MAX : (rate < INT32_MIN ? INT32_MIN : rate);
+
+                stats.slope = static_cast<SInt32>(stats.slope + ((rate - stats.slope) >> Shift));
+            }
+        }
+
+        this->minimums.push(stats.count, value);
+
+        this->maximums.push(stats.count, value);
+
+        stats.minimum = this->minimums.front();
+
+        stats.maximum = this->maximums.front();
+
+        stats.count += 1;
+
+        this->lastTimestamp = timestamp;
+
+        this->lastValue = value;
+    }
+
+    ///
+    /// Get the current statistics
+    ///
+    /// @return The statistics of all samples so far.
+    ///
+    [[nodiscard]]
+    const SensorStatistics& getStatistics() const
+    {
+        return this->statistics;
+    }
+};
+
+#endif /* SensorStatistics_hpp */
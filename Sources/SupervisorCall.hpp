@@ -0,0 +1,88 @@
+//
+//  SupervisorCall.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef SupervisorCall_hpp
+#define SupervisorCall_hpp
+
+#include <Types.hpp>
+#include <cstdint>
+#include <type_traits>
+
+///
+/// Convert a system call argument to the value of its register
+///
+template <typename T>
+static inline UInt32 toSyscallRegister(T value)
+{
+    static_assert(sizeof(T) <= sizeof(uintptr_t), "System call arguments must fit in a register.");
+
+    if constexpr (std::is_pointer_v<T>)
+    {
+        return static_cast<UInt32>(reinterpret_cast<uintptr_t>(value));
+    }
+    else
+    {
+        return static_cast<UInt32>(value);
+    }
+}
+
+///
+/// Convert the value of a register to a system call argument
+///
+template <typename T>
+static inline T fromSyscallRegister(UInt32 value)
+{
+    static_assert(sizeof(T) <= sizeof(uintptr_t), "System call arguments must fit in a register.");
+
+    if constexpr (std::is_pointer_v<T>)
+    {
+        return reinterpret_cast<T>(static_cast<uintptr_t>(value));
+    }
+    else
+    {
+        return static_cast<T>(value);
+    }
+}
+
+///
+/// Invoke the given system call
+///
+/// The system call number is encoded as the immediate of the `svc` instruction, and arguments are passed in r0 - r3.
+/// Use `Syscall<Identifier>::invoke()` instead, which checks the identifier against the system call table
+/// and the arguments against the signature of the system call.
+///
+/// @tparam Identifier The system call number (< 256)
+/// @param args At most 4 arguments
+/// @return The value the kernel has written to r0.
+///
+template <int Identifier, typename... Args>
+static inline int syscall(Args... args)
+{
+    static_assert(Identifier >= 0 && Identifier < 256, "The system call number must fit in the immediate of `svc`.");
+
+    static_assert(sizeof...(Args) <= 4, "System calls pass at most 4 arguments in registers.");
+
+    UInt32 values[4] = { toSyscallRegister(args)... };
+
+    register UInt32 r0 asm("r0") = values[0];
+
+    register UInt32 r1 asm("r1") = values[1];
+
+    register UInt32 r2 asm("r2") = values[2];
+
+    register UInt32 r3 asm("r3") = values[3];
+
+    asm volatile("svc %[identifier] \n"
+                 : "+r" (r0)
+                 : [identifier] "i" (Identifier), "r" (r1), "r" (r2), "r" (r3)
+                 : "memory"
+                 );
+
+    return static_cast<int>(r0);
+}
+
+#endif /* SupervisorCall_hpp */
@@ -6,41 +6,78 @@
 //
 
 #include "Syscall.hpp"
-#include <ARM/Syscall.hpp>
-#include <cstdarg>
 
 void sysSetEventHandler(int event, void(*handler)())
 {
-    syscall(SyscallIdentifiers::SetEventHandler, event, handler);
+    sysSetEventHandler(event, handler, kDefaultEventPriority);
+}
+
+void sysSetEventHandler(int event, void(*handler)(), UInt32 priority)
+{
+    Syscall<SyscallIdentifiers::SetEventHandler>::invoke(event, handler, priority);
 }
 
 void sysSendEvent(int event)
 {
-    syscall(SyscallIdentifiers::SendEvent, event);
+    Syscall<SyscallIdentifiers::SendEvent>::invoke(event);
 }
 
 void sysEventHandlerReturn(uint8_t* oldStack)
 {
-    syscall(SyscallIdentifiers::EventHandlerReturn, oldStack);
+    Syscall<SyscallIdentifiers::EventHandlerReturn>::invoke(oldStack);
 }
 
-int sysReadSensor(int id)
+int sysReadSensor(int id, UInt32* value)
 {
-    return syscall(SyscallIdentifiers::ReadSensor, id);
+    return Syscall<SyscallIdentifiers::ReadSensor>::invoke(id, value);
+}
+
+size_t sysReadSensorSamples(int id, Sample* samples, size_t count)
+{
+    return Syscall<SyscallIdentifiers::ReadSensorSamples>::invoke(id, samples, count);
+}
+
+int sysReadSensorStatistics(int id, SensorStatistics* statistics)
+{
+    return Syscall<SyscallIdentifiers::ReadSensorStatistics>::invoke(id, statistics);
 }
 
 size_t sysSendData(const void* bytes, size_t count)
 {
-    return syscall(SyscallIdentifiers::SendData, bytes, count);
+    return Syscall<SyscallIdentifiers::SendData>::invoke(bytes, count);
 }
 
-void sysprintf(const char* format, ...)
+size_t sysSendReadings(const WireProtocol::Reading* readings, size_t count)
 {
-    va_list args;
+    return Syscall<SyscallIdentifiers::SendReadings>::invoke(readings, count);
+}
 
-    va_start(args, format);
+int sysPostAlert(int type, UInt32 value)
+{
+    return Syscall<SyscallIdentifiers::PostAlert>::invoke(type, value);
+}
 
-    syscall(SyscallIdentifiers::Print, format, &args);
+size_t sysDumpLog(UInt32 position)
+{
+    return Syscall<SyscallIdentifiers::DumpLog>::invoke(position);
+}
+
+int sysReadEventStatistics(int event, EventStatistics* statistics)
+{
+    return Syscall<SyscallIdentifiers::ReadEventStatistics>::invoke(event, statistics);
+}
+
+UInt32 sysReadUptime()
+{
+    return Syscall<SyscallIdentifiers::ReadUptime>::invoke();
+}
+
+int sysSetTimer(int event, UInt32 milliseconds)
+{
+    return Syscall<SyscallIdentifiers::SetTimer>::invoke(event, milliseconds);
+}
 
-    va_end(args);
-}
\ No newline at end of file
+int sysSubscribe(UInt32 topic, int event)
+{
+    return Syscall<SyscallIdentifiers::Subscribe>::invoke(topic, event);
+}
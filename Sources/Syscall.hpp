@@ -9,21 +9,50 @@
 #define Syscall_hpp
 
 #include <Execution/SimpleEventDriven/Syscall.hpp>
+#include "SyscallTable.hpp"
 
-namespace SyscallIdentifiers
+/// Priority of event handlers registered without a priority (i.e. the lowest priority above the idle handler)
+static constexpr UInt32 kDefaultEventPriority = 1;
+
+void sysSetEventHandler(int event, void(*handler)(), UInt32 priority);
+
+int sysReadSensor(int id, UInt32* value);
+
+size_t sysReadSensorSamples(int id, Sample* samples, size_t count);
+
+int sysReadSensorStatistics(int id, SensorStatistics* statistics);
+
+size_t sysSendData(const void* bytes, size_t count);
+
+///
+/// Print a formatted string on the kernel console
+///
+/// @param format The format string
+/// @param args At most 3 values, each of which fits in a register
+/// @note Values are passed in registers, so the kernel never reads a `va_list` on the user stack.
+///
+template <typename... Args>
+static inline void sysprintf(const char* format, Args... args)
 {
-    static constexpr int SetEventHandler = 0;
-    static constexpr int SendEvent = 1;
-    static constexpr int EventHandlerReturn = 2;
-    static constexpr int ReadSensor = 3;
-    static constexpr int SendData = 4;
-    static constexpr int Print = 5;
+    static_assert(sizeof...(Args) <= 3, "The kernel prints at most 3 values passed in registers.");
+
+    UInt32 values[3] = { toSyscallRegister(args)... };
+
+    Syscall<SyscallIdentifiers::Print>::invoke(format, values[0], values[1], values[2]);
 }
 
-int sysReadSensor(int id);
+size_t sysSendReadings(const WireProtocol::Reading* readings, size_t count);
 
-size_t sysSendData(const void* bytes, size_t count);
+int sysPostAlert(int type, UInt32 value);
+
+size_t sysDumpLog(UInt32 position);
+
+int sysReadEventStatistics(int event, EventStatistics* statistics);
+
+UInt32 sysReadUptime();
+
+int sysSetTimer(int event, UInt32 milliseconds);
 
-void sysprintf(const char* format, ...);
+int sysSubscribe(UInt32 topic, int event);
 
 #endif /* Syscall_hpp */
@@ -0,0 +1,174 @@
+//
+//  SyscallDispatchTable.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef SyscallDispatchTable_hpp
+#define SyscallDispatchTable_hpp
+
+#include <Types.hpp>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include "SyscallTable.hpp"
+
+///
+/// A dispatch table of all system calls generated from the system call table
+///
+/// Each entry unpacks the arguments according to the signature of the system call (See `Syscall`),
+/// invokes `Routine<Identifier>::serve()` with the typed arguments and marshals the result:
+/// - If the system call returns a value, `serve()` returns the value, which is written to the stacked r0 of the caller.
+/// - Otherwise, `serve()` returns the task to run next.
+///
+/// The table is indexed by the system call number, so the kernel finds the routine without a `switch`.
+/// Missing routines and routines whose parameters cannot take the arguments of their system call fail to compile.
+///
+/// Pointer arguments are checked against the memory the caller may access before any routine follows them:
+/// - A pointer to const data must be readable by the caller, and any other data pointer must be writable by the caller.
+/// - A pointer followed by a `size_t` argument points to an array of that many elements, otherwise to a single element.
+/// - A `const char*` argument points to a string, which must be readable up to and including its terminator.
+/// - Function pointers are never followed by the kernel and are not checked.
+/// The system call is rejected if any argument fails the check.
+///
+/// @tparam Task Type of a task that supports `SyscallRegisterArgumentSupport`
+/// @tparam Routine Kernel routines, e.g. `template <int Identifier> struct Routine { static int serve(Task* current, int sensor); }`
+/// @tparam Guard Type that provides `static bool canRead(const void*, size_t)`, `static bool canWrite(const void*, size_t)`,
+///               `static bool canReadString(const char*)` and `static Task* reject(Task* current, int identifier, const void* address)`
+///
+template <typename Task, template <int> typename Routine, typename Guard>
+struct SyscallDispatchTable
+{
+    using Handler = Task* (*)(Task*);
+
+    ///
+    /// Check whether the argument at the given index is followed by the number of elements it points to
+    ///
+    template <size_t Index, typename Arguments>
+    static constexpr bool isFollowedByCount()
+    {
+        if constexpr (Index + 1 < std::tuple_size_v<Arguments>)
+        {
+            return std::is_same_v<std::tuple_element_t<Index + 1, Arguments>, size_t>;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    ///
+    /// Check whether the caller may access the memory the argument at the given index points to
+    ///
+    /// @param arguments Unpacked arguments
+    /// @param address Set to the address of the argument if the caller may not access it
+    /// @return `true` if the argument is not a data pointer or the caller may access it, `false` otherwise.
+    ///
+    template <size_t Index, typename Arguments>
+    static bool isAccessible(const Arguments& arguments, const void*& address)
+    {
+        using Argument = std::tuple_element_t<Index, Arguments>;
+
+        if constexpr (!std::is_pointer_v<Argument> || std::is_function_v<std::remove_pointer_t<Argument>>)
+        {
+            return true;
+        }
+        else
+        {
+            using Element = std::remove_pointer_t<Argument>;
+
+            address = std::get<Index>(arguments);
+
+            if constexpr (std::is_same_v<Argument, const char*>)
+            {
+                return Guard::canReadString(std::get<Index>(arguments));
+            }
+            else
+            {
+                constexpr size_t kElementSize = std::is_void_v<Element> ? 1 : sizeof(Element);
+
+                size_t count = 1;
+
+                if constexpr (isFollowedByCount<Index, Arguments>())
+                {
+                    count = std::get<Index + 1>(arguments);
+                }
+
+                if (count > static_cast<size_t>(-1) / kElementSize)
+                {
+                    return false;
+                }
+
+                return std::is_const_v<Element> ? Guard::canRead(address, count * kElementSize) :
+                                                  Guard::canWrite(address, count * kElementSize);
+            }
+        }
+    }
+
+    template <typename Arguments, size_t... Indices>
+    static bool isAccessible(const Arguments& arguments, const void*& address, std::index_sequence<Indices...>)
+    {
+        // Stop at the first violation
+        return (isAccessible<Indices>(arguments, address) && ...);
+    }
+
+    ///
+    /// Serve the system call of the given identifier
+    ///
+    template <int Identifier>
+    static Task* route(Task* current)
+    {
+        using Call = Syscall<Identifier>;
+
+        auto serve = [current](auto... args)
+        {
+            return Routine<Identifier>::serve(current, args...);
+        };
+
+        typename Call::Arguments arguments = Call::unpack(current->getSyscallRegisters());
+
+        const void* violation = nullptr;
+
+        if (!isAccessible(arguments, violation, std::make_index_sequence<std::tuple_size_v<typename Call::Arguments>>{}))
+        {
+            return Guard::reject(current, Identifier, violation);
+        }
+
+        if constexpr (std::is_void_v<typename Call::ReturnType>)
+        {
+            return std::apply(serve, arguments);
+        }
+        else
+        {
+            current->setSyscallKernelReturnValue(std::apply(serve, arguments));
+
+            return current;
+        }
+    }
+
+    template <int... Identifiers>
+    struct Entries
+    {
+        static constexpr Handler kHandlers[] = { &route<Identifiers>... };
+    };
+
+    template <int... Identifiers>
+    static constexpr auto makeEntries(std::integer_sequence<int, Identifiers...>) -> Entries<Identifiers...>;
+
+    using Table = decltype(makeEntries(std::make_integer_sequence<int, kNumSyscalls>{}));
+
+    ///
+    /// Get the handler of the given system call
+    ///
+    /// @param identifier The system call number
+    /// @param fallback The handler of unknown system calls
+    /// @return The handler of the system call, `fallback` if the identifier is unknown.
+    ///
+    static inline Handler lookup(UInt32 identifier, Handler fallback)
+    {
+        return identifier < kNumSyscalls ? Table::kHandlers[identifier] : fallback;
+    }
+};
+
+#endif /* SyscallDispatchTable_hpp */
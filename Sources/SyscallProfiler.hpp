@@ -0,0 +1,139 @@
+//
+//  SyscallProfiler.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef SyscallProfiler_hpp
+#define SyscallProfiler_hpp
+
+#include <Types.hpp>
+#include <Debug.hpp>
+#include "CycleCounter.hpp"
+
+///
+/// Measures the number of cycles the kernel spends on each service identifier
+///
+/// @note A sample starts once the kernel has saved the user context and decoded the service identifier,
+///       and ends when the kernel is about to restore the context of the next event handler.
+///       i.e. It covers the routine mapper, the kernel routine, the scheduler and the injector.
+/// @note The profiler is compiled in only if `KERNEL_SYSCALL_PROFILING` is defined.
+///
+namespace SyscallProfiler
+{
+#ifdef KERNEL_SYSCALL_PROFILING
+    /// Service identifiers include system calls (< 16) and IRQ numbers (< 32)
+    static constexpr UInt32 kMaxIdentifiers = 32;
+
+    /// Print the statistics once the given number of samples have been collected
+    static constexpr UInt32 kReportInterval = 256;
+
+    struct Statistics
+    {
+        UInt32 count;
+
+        UInt32 total;
+
+        UInt32 max;
+    };
+
+    inline Statistics gStatistics[kMaxIdentifiers];
+
+    /// Identifier of the service being served
+    inline UInt32 gIdentifier = kMaxIdentifiers;
+
+    /// Timestamp when the kernel started to serve the current service
+    inline UInt32 gTimestamp;
+
+    /// Number of samples collected since the last report
+    inline UInt32 gSamples;
+
+    ///
+    /// Start a new sample
+    ///
+    /// @param identifier The decoded service identifier
+    ///
+    static inline void onKernelEntry(UInt32 identifier)
+    {
+        gIdentifier = identifier;
+
+        gTimestamp = CycleCounter::read();
+    }
+
+    ///
+    /// Finish the current sample
+    ///
+    static inline void onKernelExit()
+    {
+        if (gIdentifier >= kMaxIdentifiers)
+        {
+            return;
+        }
+
+        UInt32 elapsed = CycleCounter::read() - gTimestamp;
+
+        Statistics& statistics = gStatistics[gIdentifier];
+
+        statistics.count += 1;
+
+        statistics.total += elapsed;
+
+        if (elapsed > statistics.max)
+        {
+            statistics.max = elapsed;
+        }
+
+        gIdentifier = kMaxIdentifiers;
+
+        gSamples += 1;
+    }
+
+    ///
+    /// Print the statistics of all services that have been sampled
+    ///
+    static inline void report()
+    {
+        kprintf("====================== Kernel Service Cycles ======================\n");
+
+        kprintf("%-8s %10s %12s %12s\n", "ID", "Count", "Avg", "Max");
+
+        for (UInt32 identifier = 0; identifier < kMaxIdentifiers; identifier += 1)
+        {
+            const Statistics& statistics = gStatistics[identifier];
+
+            if (statistics.count == 0)
+            {
+                continue;
+            }
+
+            kprintf("%-8u %10u %12u %12u\n", identifier, statistics.count, statistics.total / statistics.count, statistics.max);
+        }
+
+        kprintf("===================================================================\n");
+    }
+
+    ///
+    /// Print the statistics if enough samples have been collected since the last report
+    ///
+    static inline void reportIfNeeded()
+    {
+        if (gSamples >= kReportInterval)
+        {
+            report();
+
+            gSamples = 0;
+        }
+    }
+#else
+    static inline void onKernelEntry(UInt32) {}
+
+    static inline void onKernelExit() {}
+
+    static inline void report() {}
+
+    static inline void reportIfNeeded() {}
+#endif
+}
+
+#endif /* SyscallProfiler_hpp */
@@ -0,0 +1,168 @@
+//
+//  SyscallTable.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef SyscallTable_hpp
+#define SyscallTable_hpp
+
+#include <Types.hpp>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include "SupervisorCall.hpp"
+#include "WireProtocol.hpp"
+#include "SensorRegistry.hpp"
+#include "PendingEventQueue.hpp"
+
+namespace SyscallIdentifiers
+{
+    static constexpr int SetEventHandler = 0;
+    static constexpr int SendEvent = 1;
+    static constexpr int EventHandlerReturn = 2;
+    static constexpr int ReadSensor = 3;
+    static constexpr int SendData = 4;
+    static constexpr int Print = 5;
+    static constexpr int SendReadings = 6;
+    static constexpr int PostAlert = 7;
+    static constexpr int ReadSensorSamples = 8;
+    static constexpr int ReadSensorStatistics = 9;
+    static constexpr int DumpLog = 10;
+    static constexpr int ReadEventStatistics = 11;
+    static constexpr int ReadUptime = 12;
+    static constexpr int SetTimer = 13;
+    static constexpr int Subscribe = 14;
+}
+
+//
+// MARK: - Signatures
+//
+// The system call table is the single declaration of all system calls:
+// User stubs (`Syscall<Identifier>::invoke()`), the argument unpacking (`Syscall<Identifier>::unpack()`)
+// and the dispatch table of the kernel (See `SyscallDispatchTable`) are generated from it.
+//
+// Each system call passes at most 4 arguments in r0 - r3, and each argument must be an integer, an enumeration or a pointer.
+// The kernel reads them from the registers stacked on exception entry and never follows the user stack beyond them.
+//
+
+///
+/// Declares the signature of the system call of the given identifier (e.g. `int(int sensor)`)
+///
+template <int Identifier, typename Function>
+struct SyscallDeclaration
+{
+    static constexpr int kIdentifier = Identifier;
+
+    using Type = Function;
+};
+
+///
+/// All system calls in the order of their identifiers
+///
+/// @note The number of system calls is derived from this list, and each entry must be at the index of its identifier.
+///
+using SyscallDeclarations = std::tuple
+<
+    SyscallDeclaration<SyscallIdentifiers::SetEventHandler,      void(int, void(*)(), UInt32)>,
+    SyscallDeclaration<SyscallIdentifiers::SendEvent,            void(int)>,
+    SyscallDeclaration<SyscallIdentifiers::EventHandlerReturn,   void(UInt8*)>,
+    SyscallDeclaration<SyscallIdentifiers::ReadSensor,           int(int, UInt32*)>,
+    SyscallDeclaration<SyscallIdentifiers::SendData,             size_t(const void*, size_t)>,
+    // The format string followed by up to 3 values, so that the kernel never walks a `va_list` on the user stack
+    SyscallDeclaration<SyscallIdentifiers::Print,                void(const char*, UInt32, UInt32, UInt32)>,
+    SyscallDeclaration<SyscallIdentifiers::SendReadings,         size_t(const WireProtocol::Reading*, size_t)>,
+    SyscallDeclaration<SyscallIdentifiers::PostAlert,            int(int, UInt32)>,
+    SyscallDeclaration<SyscallIdentifiers::ReadSensorSamples,    size_t(int, Sample*, size_t)>,
+    SyscallDeclaration<SyscallIdentifiers::ReadSensorStatistics, int(int, SensorStatistics*)>,
+    SyscallDeclaration<SyscallIdentifiers::DumpLog,              size_t(UInt32)>,
+    SyscallDeclaration<SyscallIdentifiers::ReadEventStatistics,  int(int, EventStatistics*)>,
+    SyscallDeclaration<SyscallIdentifiers::ReadUptime,           UInt32()>,
+    SyscallDeclaration<SyscallIdentifiers::SetTimer,             int(int, UInt32)>,
+    SyscallDeclaration<SyscallIdentifiers::Subscribe,            int(UInt32, int)>
+>;
+
+/// The number of system calls (identifiers are dense from 0)
+static constexpr int kNumSyscalls = std::tuple_size_v<SyscallDeclarations>;
+
+template <size_t... Indices>
+static constexpr bool isSyscallTableDense(std::index_sequence<Indices...>)
+{
+    return ((std::tuple_element_t<Indices, SyscallDeclarations>::kIdentifier == static_cast<int>(Indices)) && ...);
+}
+
+static_assert(isSyscallTableDense(std::make_index_sequence<kNumSyscalls>{}),
+              "Each system call must be declared at the index of its identifier.");
+
+///
+/// Signature of the system call of the given identifier
+///
+/// @note System calls beyond the table cannot be invoked.
+///
+template <int Identifier>
+struct SyscallSignature
+{
+    static_assert(Identifier >= 0 && Identifier < kNumSyscalls, "The system call is not declared in the table.");
+
+    using Type = typename std::tuple_element_t<Identifier, SyscallDeclarations>::Type;
+};
+
+///
+/// Invokes and unpacks a system call according to its signature
+///
+/// @tparam Identifier The system call number
+/// @tparam Function The signature of the system call
+///
+template <int Identifier, typename Function = typename SyscallSignature<Identifier>::Type>
+struct Syscall;
+
+template <int Identifier, typename Return, typename... Args>
+struct Syscall<Identifier, Return(Args...)>
+{
+    // The kernel only decodes the `svc` immediate of a supervisor call, so an undeclared number is never routed
+    // to the routine of another exception, but the stub refuses to encode one in the first place
+    static_assert(Identifier >= 0 && Identifier < kNumSyscalls, "The system call is not declared in the table.");
+
+    static_assert(sizeof...(Args) <= 4, "System calls pass at most 4 arguments in registers.");
+
+    static_assert(((std::is_integral_v<Args> || std::is_enum_v<Args> || std::is_pointer_v<Args>) && ...),
+                  "System call arguments must be integers, enumerations or pointers.");
+
+    /// Type of the value returned to the caller
+    using ReturnType = Return;
+
+    /// Arguments unpacked by the kernel
+    using Arguments = std::tuple<Args...>;
+
+    ///
+    /// [User] Invoke the system call
+    ///
+    /// @param args Arguments, converted to the types in the signature
+    /// @return The value returned by the kernel.
+    ///
+    static inline Return invoke(Args... args)
+    {
+        return static_cast<Return>(syscall<Identifier>(args...));
+    }
+
+    ///
+    /// [Kernel] Unpack the arguments from the stacked registers
+    ///
+    /// @param registers Stacked r0 - r3 of the caller
+    /// @return The typed arguments.
+    ///
+    static inline Arguments unpack(const UInt32* registers)
+    {
+        return unpack(registers, std::index_sequence_for<Args...>{});
+    }
+
+private:
+    template <size_t... Indices>
+    static inline Arguments unpack(const UInt32* registers, std::index_sequence<Indices...>)
+    {
+        return Arguments(fromSyscallRegister<Args>(registers[Indices])...);
+    }
+};
+
+#endif /* SyscallTable_hpp */
@@ -84,6 +84,11 @@ namespace PL011
         writeRegister16(base, Registers::rIMSC, readRegister16(base, Registers::rIMSC) | (1 << 4));
     }
 
+    static inline void enableRxTimeoutInterrupt(UInt32 base)
+    {
+        writeRegister16(base, Registers::rIMSC, readRegister16(base, Registers::rIMSC) | (1 << 6));
+    }
+
     static inline void send(UInt32 base, UInt16 data)
     {
         // Wait until the device is idle
@@ -115,6 +120,18 @@ namespace PL011
         return readRegister16(base, Registers::rDATA);
     }
 
+    static inline bool tryReceive(UInt32 base, UInt8& byte)
+    {
+        if (isRecvEmpty(base))
+        {
+            return false;
+        }
+
+        byte = readRegister16(base, Registers::rDATA);
+
+        return true;
+    }
+
     static inline void receive(UInt32 base, void* buffer, size_t count)
     {
         for (size_t index = 0; index < count; index += 1)
@@ -135,6 +152,11 @@ namespace PL011
         writeRegister16(base, Registers::rICR, readRegister16(base, Registers::rICR) | (1 << 4));
     }
 
+    static inline void clearRxTimeoutInterrupt(UInt32 base)
+    {
+        writeRegister16(base, Registers::rICR, readRegister16(base, Registers::rICR) | (1 << 6));
+    }
+
     static inline void clearTxInterrupt(UInt32 base)
     {
         writeRegister16(base, Registers::rICR, readRegister16(base, Registers::rICR) | (1 << 5));
@@ -0,0 +1,151 @@
+//
+//  WireLink.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef WireLink_hpp
+#define WireLink_hpp
+
+#include <Types.hpp>
+#include "PL011.hpp"
+#include "../Message.hpp"
+#include "../WireProtocol.hpp"
+
+///
+/// Exchanges typed readings with a peer device over a UART port
+///
+/// @note The receiver accepts both wire protocol frames and legacy 8-byte `Message`s, each of which is delivered as a single reading of sensor 0,
+///       unless the kernel is built with `KERNEL_FRAMES_ONLY_WIRE`, in which case it accepts wire protocol frames only.
+/// @note The sender always uses wire protocol frames and batches up to `WireProtocol::kMaxReadings` readings per frame.
+///
+class WireLink
+{
+#ifdef KERNEL_FRAMES_ONLY_WIRE
+    static constexpr bool kAcceptLegacy = false;
+#else
+    static constexpr bool kAcceptLegacy = true;
+#endif
+
+    using Receiver = WireProtocol::Receiver<kAcceptLegacy>;
+
+    /// Base address of the UART port
+    UInt32 base;
+
+    /// Receiver of wire protocol frames and legacy messages
+    Receiver receiver;
+
+    /// Sequence number of the next frame to send
+    UInt16 sequence = 0;
+
+public:
+    ///
+    /// Create a link on the given UART port
+    ///
+    /// @param base Base address of the UART port
+    ///
+    explicit WireLink(UInt32 base) : base(base) {}
+
+    ///
+    /// Drain the receive FIFO and deliver all complete readings
+    ///
+    /// @param handler A callable object invoked with a `const WireProtocol::Reading&` for each received reading
+    /// @return The number of frames discarded due to a corruption.
+    ///
+    template <typename Handler>
+    size_t receive(Handler handler)
+    {
+        size_t discarded = 0;
+
+        UInt8 byte;
+
+        while (PL011::tryReceive(this->base, byte))
+        {
+            switch (this->receiver.feed(byte))
+            {
+                case Receiver::Status::kFrame:
+                {
+                    const WireProtocol::Frame& frame = this->receiver.getFrame();
+
+                    for (size_t index = 0; index < frame.count; index += 1)
+                    {
+                        handler(frame.readings[index]);
+                    }
+
+                    break;
+                }
+
+                case Receiver::Status::kLegacyMessage:
+                    handler(this->receiver.getLegacyMessage());
+
+                    break;
+
+                case Receiver::Status::kError:
+                    discarded += 1;
+
+                    break;
+
+                case Receiver::Status::kPending:
+                    break;
+            }
+        }
+
+        return discarded;
+    }
+
+    ///
+    /// Send the given frame with a new sequence number
+    ///
+    /// @param frame The frame to send, whose sequence number is assigned by the link
+    /// @return The sequence number assigned to the frame.
+    ///
+    UInt16 send(WireProtocol::Frame& frame)
+    {
+        frame.sequence = this->sequence;
+
+        this->sequence += 1;
+
+        this->transmit(frame);
+
+        return frame.sequence;
+    }
+
+    ///
+    /// Send the given frame as is
+    ///
+    /// @param frame The frame to send
+    /// @note This function is intended to retransmit a frame with its original sequence number.
+    ///
+    void transmit(const WireProtocol::Frame& frame)
+    {
+        UInt8 bytes[WireProtocol::kMaxFrameSize];
+
+        PL011::send(this->base, bytes, WireProtocol::encode(frame, bytes));
+    }
+
+    ///
+    /// Send the given readings in as few frames as possible
+    ///
+    /// @param readings The readings to send
+    /// @param count The number of readings
+    ///
+    void send(const WireProtocol::Reading* readings, size_t count)
+    {
+        WireProtocol::Frame frame = {};
+
+        for (size_t index = 0; index < count; index += 1)
+        {
+            frame.append(readings[index].type, readings[index].sensor, readings[index].value);
+
+            if (frame.count == WireProtocol::kMaxReadings || index + 1 == count)
+            {
+                this->send(frame);
+
+                frame.count = 0;
+            }
+        }
+    }
+};
+
+#endif /* WireLink_hpp */
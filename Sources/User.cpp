@@ -8,12 +8,16 @@
 #include "User.hpp"
 #include "Syscall.hpp"
 #include "Message.hpp"
+#include "HandlerCoroutine.hpp"
+#include "Mailboxes.hpp"
 
 // Remove all printing if we are running experiments to measure the stack usage
 #ifdef RUN_STACK_EXP
     #define sysprintf (void)
 #endif
 
+// The kernel idles in handler mode and never switches to this handler (See `KernelIdle`)
+// It is registered only to provide the execution context the idle event is created with
 __attribute__((noreturn))
 void idleHandler()
 {
@@ -23,77 +27,148 @@ void idleHandler()
     }
 }
 
-void readSensor()
+///
+/// Read the average moisture level of the bed
+///
+/// @return The moisture level in percentage, `-1` if the sensor has not reported any reading yet.
+///
+static int readMoistureLevel()
 {
-    // Read the moisture level (in percentage)
-    sysprintf("=================================================\n");
-
     sysprintf("RSH: Prepare to read the moisture sensor.\n");
 
-    int moisture = sysReadSensor(0);
+    SensorStatistics statistics;
 
-    sysprintf("RSH: The current moisture level is %d%%.\n", moisture);
-
-    if (moisture < 30)
+    if (sysReadSensorStatistics(0, &statistics) != 0)
     {
-        sysprintf("RSH: The moisture level has fallen below the threshold.\n");
+        sysprintf("RSH: The sensor has not reported any reading yet.\n");
 
-        sysprintf("RSH: Will notify the dry soil handler.\n");
-
-        sysSendEvent(kDrySoilEvent);
+        return -1;
     }
-    else
+
+    // Decide on the moving average rather than the latest reading, so that a single noisy sample does not trigger an alert
+    int moisture = static_cast<int>(statistics.average >> 8);
+
+    sysprintf("RSH: The average moisture level is %d%% (Min = %d%%, Max = %d%%).\n", moisture, statistics.minimum, statistics.maximum);
+
+    return moisture;
+}
+
+///
+/// Take all raw readings in the reading mailbox
+///
+/// @param sensor Identifier of the sensor
+/// @return The latest moisture level reported by the given sensor, `-1` if there is none.
+///
+static int takeLatestReading(int sensor)
+{
+    int moisture = -1;
+
+    while (const WireProtocol::Reading* reading = gReadingMailbox.peek())
     {
-        sysprintf("RSH: No need to water the plant.\n");
+        if (reading->sensor == sensor)
+        {
+            moisture = static_cast<int>(reading->value);
+        }
+
+        gReadingMailbox.release();
     }
 
-    sysprintf("=================================================\n");
+    return moisture;
 }
 
-void readSensorWet()
+///
+/// Hand the moisture level over to the handler of the given mailbox
+///
+template <typename Mailbox>
+static void notifyAlertHandler(Mailbox& mailbox, int moisture)
 {
-    // Read the moisture level (in percentage)
-    sysprintf("=================================================\n");
+    if (!mailbox.send(moisture))
+    {
+        sysprintf("RSH: The alert handler has not taken the previous moisture levels yet.\n");
+    }
+}
 
-    sysprintf("RSH: Prepare to read the moisture sensor.\n");
+// Runs one step each time the sensor event is posted (periodically or once the moisture level changes), and keeps its state across readings in its coroutine frame
+HandlerCoroutine wateringProtocol()
+{
+    while (true)
+    {
+        // Wait until the soil is dry
+        int moisture;
 
-    int moisture = sysReadSensor(0);
+        do
+        {
+            co_await Coroutines::nextEvent(kSensorEvent);
 
-    sysprintf("RSH: The current moisture level is %d%%.\n", moisture);
+            moisture = readMoistureLevel();
+        }
+        while (moisture < 0 || moisture >= 30);
+
+        sysprintf("RSH: The moisture level has fallen below the threshold. Will confirm it shortly.\n");
+
+        // Let the soil settle and confirm with the next raw reading, which the moving average lags behind
+        co_await Coroutines::sleepFor(kConfirmationDelay);
+
+        gReadingMailbox.clear();
+
+        do
+        {
+            co_await Coroutines::nextEvent(kReadingEvent);
+
+            moisture = takeLatestReading(0);
+        }
+        while (moisture < 0);
+
+        if (moisture >= 30)
+        {
+            sysprintf("RSH: The latest moisture level is %d%%. No need to water the plant.\n", moisture);
+
+            continue;
+        }
+
+        sysprintf("RSH: Will notify the dry soil handler.\n");
+
+        notifyAlertHandler(gDrySoilMailbox, moisture);
+
+        // Wait until the soil is wet
+        do
+        {
+            co_await Coroutines::nextEvent(kSensorEvent);
+
+            moisture = readMoistureLevel();
+        }
+        while (moisture <= 50);
 
-    if (moisture > 50)
-    {
         sysprintf("RSH: The moisture level has reached the upper threshold.\n");
 
         sysprintf("RSH: Will notify the wet soil handler.\n");
 
-        sysSendEvent(kWetSoilEvent);
+        notifyAlertHandler(gWetSoilMailbox, moisture);
     }
-    else
-    {
-        sysprintf("RSH: The moisture level has not yet reached the upper threshold.\n");
-    }
-
-    sysprintf("=================================================\n");
 }
 
 void drySoilHandler()
 {
     sysprintf("=================================================\n");
 
-    sysprintf("DSH: Prepare to send a Dry Soil Alert to the actuator.\n");
+    // The mailbox holds the moisture level that triggers each alert
+    while (const UInt32* moisture = gDrySoilMailbox.peek())
+    {
+        sysprintf("DSH: Prepare to send a Dry Soil Alert to the actuator (Moisture = %d%%).\n", *moisture);
 
-    Message alert = Message::soilDryAlert();
+        // The kernel retransmits the alert until the actuator acknowledges it
+        int sequence = sysPostAlert(Message::Type::kSoilDryAlert, *moisture);
 
-    if (sysSendData(&alert, sizeof(Message)) == sizeof(Message))
-    {
-        sysprintf("DSH: Alert has been sent.\n");
+        gDrySoilMailbox.release();
 
-        sysSetEventHandler(kSensorEvent, readSensorWet);
-    }
-    else
-    {
-        sysprintf("DSH: Failed to send the alert.\n");
+        if (sequence >= 0)
+        {
+            sysprintf("DSH: Alert #%d has been posted.\n", sequence);
+        }
+        else
+        {
+            sysprintf("DSH: Failed to post the alert. Too many alerts in flight.\n");
+        }
     }
 
     sysprintf("=================================================\n");
@@ -103,20 +178,44 @@ void wetSoilHandler()
 {
     sysprintf("=================================================\n");
 
-    sysprintf("WSH: Prepare to send a Wet Soil Alert to the actuator.\n");
+    // The mailbox holds the moisture level that triggers each alert
+    while (const UInt32* moisture = gWetSoilMailbox.peek())
+    {
+        sysprintf("WSH: Prepare to send a Wet Soil Alert to the actuator (Moisture = %d%%).\n", *moisture);
 
-    Message alert = Message::soilWetAlert();
+        // The kernel retransmits the alert until the actuator acknowledges it
+        int sequence = sysPostAlert(Message::Type::kSoilWetAlert, *moisture);
 
-    if (sysSendData(&alert, sizeof(Message)) == sizeof(Message))
-    {
-        sysprintf("WSH: Alert has been sent.\n");
+        gWetSoilMailbox.release();
 
-        sysSetEventHandler(kSensorEvent, readSensor);
-    }
-    else
-    {
-        sysprintf("WSH: Failed to send the alert.\n");
+        if (sequence >= 0)
+        {
+            sysprintf("WSH: Alert #%d has been posted.\n", sequence);
+        }
+        else
+        {
+            sysprintf("WSH: Failed to post the alert. Too many alerts in flight.\n");
+        }
     }
 
     sysprintf("=================================================\n");
-}
\ No newline at end of file
+}
+
+void alertDroppedHandler()
+{
+    // The mailbox holds the alerts that the actuator has never acknowledged
+    while (const WireProtocol::Reading* alert = gDroppedAlertMailbox.peek())
+    {
+        sysprintf("ADH: The actuator has not acknowledged the alert (Type = %d, Moisture = %d%%). Will post it again.\n", alert->type, alert->value);
+
+        // The alert handler posts the alert again, so that the plant is still watered once the actuator comes back
+        bool forwarded = alert->type == Message::Type::kSoilDryAlert ? gDrySoilMailbox.send(alert->value) : gWetSoilMailbox.send(alert->value);
+
+        gDroppedAlertMailbox.release();
+
+        if (!forwarded)
+        {
+            sysprintf("ADH: The alert handler has newer moisture levels to send. Will drop the alert.\n");
+        }
+    }
+}
@@ -12,10 +12,13 @@
 // Deployment: Event Handlers
 //
 // Event Identifiers:
-// Event 0: Idle (Reserved)
-// Event 1: Periodic Sensor Reading
+// Event 0: Idle (Reserved, served by the kernel)
+// Event 1: Periodic Sensor Reading (Also published by UART1 once the moisture level changes)
 // Event 2: Dry Soil (Notify the actuator to start watering the plant)
 // Event 3: Wet Soil (Notify the actuator to stop watering the plant)
+// Event 4: Timer (Resume coroutine handlers whose timer has expired)
+// Event 5: Raw Reading (Posted by UART1 once a moisture reading arrives in an empty reading mailbox)
+// Event 6: Dropped Alert (Posted by the kernel once it gives up delivering an alert to the actuator)
 //
 
 enum UserEvent
@@ -23,16 +26,71 @@ enum UserEvent
     kIdleEvent = 0,
     kSensorEvent = 1,
     kDrySoilEvent = 2,
-    kWetSoilEvent = 3
+    kWetSoilEvent = 3,
+    kTimerEvent = 4,
+    kReadingEvent = 5,
+    kAlertDroppedEvent = 6,
+    kNumUserEvents = 7
 };
 
+//
+// Event Priorities:
+// Alert handlers preempt the periodic sensor reading, which spends most of its time printing,
+// so that the latency of an alert is bounded even if the system is busy.
+//
+
+enum UserEventPriority
+{
+    kIdlePriority = 0,
+    kReportPriority = 1,
+    kAlertPriority = 2
+};
+
+//
+// Event Deadlines (in milliseconds after the event is posted):
+// The periodic sensor reading must complete before the next period starts.
+// Alert handlers must hand the alert over to the kernel quickly, so that the actuator reacts in time.
+//
+
+enum UserEventDeadline
+{
+    kSensorDeadline = 5000,
+    kAlertDeadline = 50
+};
+
+//
+// Event Execution Budgets (in milliseconds of execution each time the event is posted):
+// The kernel aborts a handler that runs longer, so that a runaway handler cannot starve the handlers of the same priority.
+// Budgets are well below the deadlines, since a handler may also wait for preempting handlers.
+//
+
+enum UserEventBudget
+{
+    kSensorBudget = 1000,
+    kAlertBudget = 20
+};
+
+//
+// Delays (in milliseconds)
+// A single dry reading may be a glitch, so the watering protocol confirms it with the next raw reading after a while.
+//
+
+enum UserDelay
+{
+    kConfirmationDelay = 1000
+};
+
+struct HandlerCoroutine;
+
 __attribute__((noreturn))
 void idleHandler();
 
-void readSensor();
+HandlerCoroutine wateringProtocol();
 
 void drySoilHandler();
 
 void wetSoilHandler();
 
+void alertDroppedHandler();
+
 #endif /* User_hpp */
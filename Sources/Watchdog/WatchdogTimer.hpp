@@ -0,0 +1,125 @@
+//
+//  WatchdogTimer.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef WatchdogTimer_hpp
+#define WatchdogTimer_hpp
+
+#include <Types.hpp>
+
+///
+/// Driver of the watchdog timer of Stellaris LM3S811
+///
+/// The timer counts down from the load value and raises its interrupt once it reaches zero, then reloads and counts down again.
+/// If the interrupt has not been cleared by the second time the counter reaches zero, the timer resets the system.
+///
+/// @note Once started, the timer cannot be stopped other than by a reset.
+/// @ref Section 10 Watchdog Timer in LM3S811 Manual
+///
+namespace WatchdogTimer
+{
+    namespace Registers
+    {
+        static constexpr UInt32 rWDTLOAD = 0x40000000;
+        static constexpr UInt32 rWDTCTL  = 0x40000008;
+        static constexpr UInt32 rWDTICR  = 0x4000000C;
+        static constexpr UInt32 rWDTTEST = 0x40000418;
+        static constexpr UInt32 rWDTLOCK = 0x40000C00;
+
+        /// Run-Mode Clock Gating Control Register 0 (System Control)
+        static constexpr UInt32 rRCGC0   = 0x400FE100;
+
+        /// Reset Cause Register (System Control)
+        static constexpr UInt32 rRESC    = 0x400FE05C;
+    }
+
+    namespace Bits
+    {
+        /// WDTCTL: Enable the counter and the interrupt
+        static constexpr UInt32 kInterruptEnable = 1 << 0;
+
+        /// WDTCTL: Reset the system on the second timeout
+        static constexpr UInt32 kResetEnable = 1 << 1;
+
+        /// WDTTEST: Stop counting while the processor is halted by a debugger
+        static constexpr UInt32 kStall = 1 << 8;
+
+        /// RCGC0: Watchdog clock
+        static constexpr UInt32 kClockGate = 1 << 3;
+
+        /// RESC: Reset caused by the watchdog timer
+        static constexpr UInt32 kWatchdogReset = 1 << 3;
+    }
+
+    /// Writing this value to WDTLOCK unlocks other registers, while writing any other value locks them
+    static constexpr UInt32 kUnlockKey = 0x1ACCE551;
+
+    static inline UInt32 readRegister32(UInt32 address)
+    {
+        return *reinterpret_cast<volatile UInt32*>(address);
+    }
+
+    static inline void writeRegister32(UInt32 address, UInt32 value)
+    {
+        *reinterpret_cast<volatile UInt32*>(address) = value;
+    }
+
+    ///
+    /// Start the watchdog timer
+    ///
+    /// @param cycles Number of processor cycles between two timeouts
+    /// @note The system resets if the timer is not fed for twice the given number of cycles.
+    ///
+    static inline void start(UInt32 cycles)
+    {
+        writeRegister32(Registers::rRCGC0, readRegister32(Registers::rRCGC0) | Bits::kClockGate);
+
+        // The peripheral is accessible a few cycles after its clock is enabled
+        (void) readRegister32(Registers::rRCGC0);
+
+        writeRegister32(Registers::rWDTLOCK, kUnlockKey);
+
+        writeRegister32(Registers::rWDTLOAD, cycles);
+
+        writeRegister32(Registers::rWDTTEST, Bits::kStall);
+
+        writeRegister32(Registers::rWDTCTL, Bits::kResetEnable);
+
+        writeRegister32(Registers::rWDTCTL, Bits::kResetEnable | Bits::kInterruptEnable);
+
+        writeRegister32(Registers::rWDTLOCK, 0);
+    }
+
+    ///
+    /// Feed the watchdog timer
+    ///
+    /// Clears the interrupt and reloads the counter.
+    ///
+    static inline void feed()
+    {
+        writeRegister32(Registers::rWDTLOCK, kUnlockKey);
+
+        writeRegister32(Registers::rWDTICR, 0);
+
+        writeRegister32(Registers::rWDTLOCK, 0);
+    }
+
+    ///
+    /// Check whether the last reset was caused by the watchdog timer and clear the cause
+    ///
+    /// @return `true` if the watchdog timer has reset the system, `false` otherwise.
+    ///
+    static inline bool checkAndClearReset()
+    {
+        UInt32 cause = readRegister32(Registers::rRESC);
+
+        writeRegister32(Registers::rRESC, cause & ~Bits::kWatchdogReset);
+
+        return (cause & Bits::kWatchdogReset) != 0;
+    }
+}
+
+#endif /* WatchdogTimer_hpp */
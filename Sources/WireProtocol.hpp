@@ -0,0 +1,537 @@
+//
+//  WireProtocol.hpp
+//  Kernel-ARM~Moisture
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef WireProtocol_hpp
+#define WireProtocol_hpp
+
+// This header is shared by the kernel and host tools,
+// so it only depends on freestanding headers and does not rely on Tinkertoy types.
+#include <cstddef>
+#include <cstdint>
+
+///
+/// A compact, versioned binary protocol that carries multiple typed readings per frame
+///
+/// Frame layout before encoding (all multi-byte fields are little endian):
+///
+/// | Offset | Size   | Field                                            |
+/// |--------|--------|--------------------------------------------------|
+/// | 0      | 1      | Version (`kVersion`)                             |
+/// | 1      | 1      | Length of the readings in bytes (`6 * count`)    |
+/// | 2      | 2      | Sequence number                                  |
+/// | 4      | 6 * N  | Readings: type (1), sensor (1), value (4)        |
+/// | 4 + 6N | 2      | CRC-16/CCITT-FALSE of all preceding bytes        |
+///
+/// Each frame is then COBS-encoded and terminated by a zero byte,
+/// so a receiver can always resynchronize at the next delimiter after a corrupted frame.
+///
+/// @note A frame carries at most `kMaxReadings` readings, so the first byte on the wire (i.e. the COBS code byte)
+///       is always less than 0x57 and never collides with the first byte of the legacy 8-byte `Message` (magic 0x4657).
+///       This allows a receiver to accept both formats on the same serial port (See `Receiver`).
+///
+namespace WireProtocol
+{
+    /// Current protocol version
+    static constexpr uint8_t kVersion = 1;
+
+    /// Maximum number of readings in a single frame
+    static constexpr size_t kMaxReadings = 8;
+
+    static constexpr size_t kHeaderSize = 4;
+
+    static constexpr size_t kReadingSize = 6;
+
+    static constexpr size_t kChecksumSize = 2;
+
+    /// Maximum size of a frame before encoding
+    static constexpr size_t kMaxPayloadSize = kHeaderSize + kMaxReadings * kReadingSize + kChecksumSize;
+
+    /// Maximum size of a frame on the wire (i.e. one COBS code byte per 254 bytes and the delimiter)
+    static constexpr size_t kMaxFrameSize = kMaxPayloadSize + kMaxPayloadSize / 254 + 1 + 1;
+
+    static_assert(kMaxPayloadSize + 1 < 0x57, "The COBS code byte must not collide with the legacy message magic.");
+
+    /// A typed reading
+    struct Reading
+    {
+        /// Type of the reading (See `Message::Type`)
+        uint8_t type;
+
+        /// Identifier of the sensor that produced the reading
+        uint8_t sensor;
+
+        /// Value of the reading
+        uint32_t value;
+    };
+
+    /// A decoded frame
+    struct Frame
+    {
+        uint16_t sequence;
+
+        uint8_t count;
+
+        Reading readings[kMaxReadings];
+
+        ///
+        /// Append a reading to the frame
+        ///
+        /// @param type Type of the reading
+        /// @param sensor Identifier of the sensor
+        /// @param value Value of the reading
+        /// @return `true` on success, `false` if the frame is full.
+        ///
+        bool append(uint8_t type, uint8_t sensor, uint32_t value)
+        {
+            if (this->count >= kMaxReadings)
+            {
+                return false;
+            }
+
+            this->readings[this->count] = {type, sensor, value};
+
+            this->count += 1;
+
+            return true;
+        }
+    };
+
+    ///
+    /// Compute the CRC-16/CCITT-FALSE checksum of the given bytes
+    ///
+    /// @param bytes The bytes to checksum
+    /// @param count The number of bytes
+    /// @param crc The initial value or the checksum of preceding bytes
+    /// @return The checksum.
+    /// @note A 16-entry table trades a few cycles per byte for 480 bytes of flash compared to a 256-entry table.
+    ///
+    static inline uint16_t crc16(const uint8_t* bytes, size_t count, uint16_t crc = 0xFFFF)
+    {
+        static constexpr uint16_t kTable[16] =
+        {
+            0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+            0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+        };
+
+        for (size_t index = 0; index < count; index += 1)
+        {
+            crc = static_cast<uint16_t>((crc << 4) ^ kTable[(crc >> 12) ^ (bytes[index] >> 4)]);
+
+            crc = static_cast<uint16_t>((crc << 4) ^ kTable[(crc >> 12) ^ (bytes[index] & 0x0F)]);
+        }
+
+        return crc;
+    }
+
+    ///
+    /// COBS-encode the given bytes and append the delimiter
+    ///
+    /// @param input The bytes to encode
+    /// @param count The number of bytes to encode
+    /// @param output A buffer of at least `count + count / 254 + 2` bytes
+    /// @return The number of bytes written to the output buffer, including the delimiter.
+    ///
+    static inline size_t cobsEncode(const uint8_t* input, size_t count, uint8_t* output)
+    {
+        size_t code = 0;
+
+        size_t length = 1;
+
+        uint8_t run = 1;
+
+        for (size_t index = 0; index < count; index += 1)
+        {
+            if (input[index] != 0)
+            {
+                output[length] = input[index];
+
+                length += 1;
+
+                run += 1;
+            }
+
+            if (input[index] == 0 || run == 0xFF)
+            {
+                output[code] = run;
+
+                code = length;
+
+                length += 1;
+
+                run = 1;
+            }
+        }
+
+        output[code] = run;
+
+        output[length] = 0;
+
+        return length + 1;
+    }
+
+    ///
+    /// Decode the given COBS-encoded bytes in place
+    ///
+    /// @param buffer The encoded bytes without the delimiter
+    /// @param count The number of encoded bytes
+    /// @return The number of decoded bytes, `0` if the input is malformed.
+    ///
+    static inline size_t cobsDecode(uint8_t* buffer, size_t count)
+    {
+        size_t input = 0;
+
+        size_t output = 0;
+
+        while (input < count)
+        {
+            uint8_t code = buffer[input];
+
+            if (code == 0)
+            {
+                return 0;
+            }
+
+            input += 1;
+
+            for (uint8_t index = 1; index < code; index += 1)
+            {
+                if (input >= count)
+                {
+                    return 0;
+                }
+
+                buffer[output] = buffer[input];
+
+                output += 1;
+
+                input += 1;
+            }
+
+            if (code != 0xFF && input < count)
+            {
+                buffer[output] = 0;
+
+                output += 1;
+            }
+        }
+
+        return output;
+    }
+
+    ///
+    /// Encode the given frame
+    ///
+    /// @param frame The frame to encode
+    /// @param output A buffer of at least `kMaxFrameSize` bytes
+    /// @return The number of bytes to send, including the delimiter.
+    ///
+    static inline size_t encode(const Frame& frame, uint8_t* output)
+    {
+        uint8_t payload[kMaxPayloadSize];
+
+        size_t length = 0;
+
+        payload[length++] = kVersion;
+
+        payload[length++] = static_cast<uint8_t>(frame.count * kReadingSize);
+
+        payload[length++] = static_cast<uint8_t>(frame.sequence);
+
+        payload[length++] = static_cast<uint8_t>(frame.sequence >> 8);
+
+        for (size_t index = 0; index < frame.count; index += 1)
+        {
+            const Reading& reading = frame.readings[index];
+
+            payload[length++] = reading.type;
+
+            payload[length++] = reading.sensor;
+
+            for (size_t shift = 0; shift < 32; shift += 8)
+            {
+                payload[length++] = static_cast<uint8_t>(reading.value >> shift);
+            }
+        }
+
+        uint16_t crc = crc16(payload, length);
+
+        payload[length++] = static_cast<uint8_t>(crc);
+
+        payload[length++] = static_cast<uint8_t>(crc >> 8);
+
+        return cobsEncode(payload, length, output);
+    }
+
+    ///
+    /// A streaming frame decoder
+    ///
+    /// Usage:
+    /// ```
+    /// Decoder decoder;
+    /// for each received byte:
+    ///     if (decoder.feed(byte) == Decoder::Status::kFrame)
+    ///         consume decoder.getFrame()
+    /// ```
+    ///
+    class Decoder
+    {
+    public:
+        enum class Status
+        {
+            /// The frame is incomplete
+            kPending,
+
+            /// A valid frame has been decoded
+            kFrame,
+
+            /// A frame has been discarded (malformed, too long, unsupported version or checksum mismatch)
+            kError,
+        };
+
+    private:
+        uint8_t buffer[kMaxFrameSize];
+
+        size_t length = 0;
+
+        bool overflow = false;
+
+        Frame frame = {};
+
+        Status parse()
+        {
+            size_t count = cobsDecode(this->buffer, this->length);
+
+            if (count < kHeaderSize + kChecksumSize || this->buffer[0] != kVersion)
+            {
+                return Status::kError;
+            }
+
+            size_t readings = this->buffer[1];
+
+            if (readings % kReadingSize != 0 || readings > kMaxReadings * kReadingSize || count != kHeaderSize + readings + kChecksumSize)
+            {
+                return Status::kError;
+            }
+
+            uint16_t crc = static_cast<uint16_t>(this->buffer[count - 2] | (this->buffer[count - 1] << 8));
+
+            if (crc16(this->buffer, count - kChecksumSize) != crc)
+            {
+                return Status::kError;
+            }
+
+            this->frame.sequence = static_cast<uint16_t>(this->buffer[2] | (this->buffer[3] << 8));
+
+            this->frame.count = 0;
+
+            for (const uint8_t* reading = this->buffer + kHeaderSize; reading < this->buffer + kHeaderSize + readings; reading += kReadingSize)
+            {
+                uint32_t value = static_cast<uint32_t>(reading[2]) |
+                                 static_cast<uint32_t>(reading[3]) << 8 |
+                                 static_cast<uint32_t>(reading[4]) << 16 |
+                                 static_cast<uint32_t>(reading[5]) << 24;
+
+                this->frame.append(reading[0], reading[1], value);
+            }
+
+            return Status::kFrame;
+        }
+
+    public:
+        ///
+        /// Feed a received byte to the decoder
+        ///
+        /// @param byte The received byte
+        /// @return The decoder status after consuming the given byte.
+        ///
+        Status feed(uint8_t byte)
+        {
+            if (byte != 0)
+            {
+                if (this->length < kMaxFrameSize)
+                {
+                    this->buffer[this->length] = byte;
+
+                    this->length += 1;
+                }
+                else
+                {
+                    this->overflow = true;
+                }
+
+                return Status::kPending;
+            }
+
+            // Delimiter: Parse the frame and get ready for the next one
+            Status status = this->length == 0 ? Status::kPending : (this->overflow ? Status::kError : this->parse());
+
+            this->length = 0;
+
+            this->overflow = false;
+
+            return status;
+        }
+
+        ///
+        /// Reset the decoder and discard any partially received frame
+        ///
+        void reset()
+        {
+            this->length = 0;
+
+            this->overflow = false;
+        }
+
+        ///
+        /// Get the most recently decoded frame
+        ///
+        /// @return The frame decoded when `feed()` last returned `Status::kFrame`.
+        ///
+        [[nodiscard]]
+        const Frame& getFrame() const
+        {
+            return this->frame;
+        }
+    };
+
+    /// Size of a legacy `Message` on the wire: magic (2), type (2) and data (4), all little endian
+    static constexpr size_t kLegacyMessageSize = 8;
+
+    /// Magic of a legacy `Message`
+    static constexpr uint16_t kLegacyMagic = 0x4657;
+
+    ///
+    /// A streaming receiver that tells wire protocol frames and legacy 8-byte `Message`s apart
+    ///
+    /// Legacy messages start with the magic 0x4657 in little endian, whose first byte never starts a frame.
+    /// A legacy message is delivered as a single reading of sensor 0.
+    ///
+    /// @tparam AcceptLegacy `true` to accept legacy messages, `false` to treat their bytes as part of a (corrupted) frame
+    /// @note Legacy messages carry no checksum, so a corrupted value would go unnoticed.
+    ///       The kernel rejects them if it is built with `KERNEL_FRAMES_ONLY_WIRE`.
+    ///
+    template <bool AcceptLegacy>
+    class Receiver
+    {
+    public:
+        enum class Status
+        {
+            /// The frame or message is incomplete
+            kPending,
+
+            /// A valid frame has been decoded
+            kFrame,
+
+            /// A valid legacy message has been received
+            kLegacyMessage,
+
+            /// A frame or legacy message has been discarded
+            kError,
+        };
+
+    private:
+        Decoder decoder;
+
+        /// Bytes of the legacy message being received
+        uint8_t legacy[kLegacyMessageSize];
+
+        /// Number of bytes of the legacy message that have been received
+        size_t legacyLength = 0;
+
+        /// `true` if the next byte starts a new frame or message
+        bool atFrameStart = true;
+
+        /// The most recently received legacy message
+        Reading message = {};
+
+        Status feedLegacy(uint8_t byte)
+        {
+            this->legacy[this->legacyLength] = byte;
+
+            this->legacyLength += 1;
+
+            if (this->legacyLength < kLegacyMessageSize)
+            {
+                return Status::kPending;
+            }
+
+            this->legacyLength = 0;
+
+            if ((this->legacy[0] | this->legacy[1] << 8) != kLegacyMagic)
+            {
+                return Status::kError;
+            }
+
+            this->message.type = this->legacy[2];
+
+            this->message.sensor = 0;
+
+            this->message.value = static_cast<uint32_t>(this->legacy[4]) |
+                                  static_cast<uint32_t>(this->legacy[5]) << 8 |
+                                  static_cast<uint32_t>(this->legacy[6]) << 16 |
+                                  static_cast<uint32_t>(this->legacy[7]) << 24;
+
+            return Status::kLegacyMessage;
+        }
+
+    public:
+        ///
+        /// Feed a received byte to the receiver
+        ///
+        /// @param byte The received byte
+        /// @return The receiver status after consuming the given byte.
+        ///
+        Status feed(uint8_t byte)
+        {
+            if constexpr (AcceptLegacy)
+            {
+                if (this->legacyLength > 0 || (this->atFrameStart && byte == (kLegacyMagic & 0xFF)))
+                {
+                    return this->feedLegacy(byte);
+                }
+            }
+
+            this->atFrameStart = byte == 0;
+
+            switch (this->decoder.feed(byte))
+            {
+                case Decoder::Status::kFrame:
+                    return Status::kFrame;
+
+                case Decoder::Status::kError:
+                    return Status::kError;
+
+                default:
+                    return Status::kPending;
+            }
+        }
+
+        ///
+        /// Get the most recently decoded frame
+        ///
+        /// @return The frame decoded when `feed()` last returned `Status::kFrame`.
+        ///
+        [[nodiscard]]
+        const Frame& getFrame() const
+        {
+            return this->decoder.getFrame();
+        }
+
+        ///
+        /// Get the most recently received legacy message
+        ///
+        /// @return The message received when `feed()` last returned `Status::kLegacyMessage`, as a reading of sensor 0.
+        ///
+        [[nodiscard]]
+        const Reading& getLegacyMessage() const
+        {
+            return this->message;
+        }
+    };
+}
+
+#endif /* WireProtocol_hpp */
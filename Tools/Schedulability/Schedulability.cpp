@@ -0,0 +1,324 @@
+//
+//  Schedulability.cpp
+//  Schedulability
+//
+//  Created by agent on 10/19/26.
+//
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include "DeadlineQueue.hpp"
+#include "User.hpp"
+
+//
+// Usage:
+//
+// Check whether the event handlers of the moisture device meet their deadlines under EDF scheduling:
+//     Schedulability
+//
+// Check a custom task set (<name>:<wcet>:<relative deadline>:<period> in milliseconds):
+//     Schedulability sensor:20:5000:5000 alert:2:50:5000
+//
+// The tool applies the processor demand criterion and then simulates the task set with the ready queue used by the kernel.
+// Sporadic events (e.g. alerts) are modeled as periodic tasks released at their minimum inter-arrival time,
+// and all tasks are released at time 0, which is the worst case for EDF.
+// The exit status is non-zero if any deadline can be missed.
+//
+
+struct Task
+{
+    const char* name;
+
+    /// Worst-case execution time
+    UInt32 wcet;
+
+    /// Relative deadline
+    UInt32 deadline;
+
+    /// Period or minimum inter-arrival time
+    UInt32 period;
+};
+
+/// The maximum number of tasks in a task set
+static constexpr size_t kMaxTasks = 16;
+
+/// The maximum number of milliseconds to simulate
+static constexpr UInt64 kMaxSimulationTime = 100'000'000;
+
+///
+/// Event handlers of the moisture device
+///
+/// @note Execution times are estimates on the 50 MHz target, including the time spent printing over UART0.
+///       Alert handlers are posted by the periodic sensor reading, so they arrive at most once per sensor period.
+///
+static const Task kDefaultTaskSet[] =
+{
+    {"Sensor", 20, kSensorDeadline, kSensorDeadline},
+    {"Dry Soil", 2, kAlertDeadline, kSensorDeadline},
+    {"Wet Soil", 2, kAlertDeadline, kSensorDeadline},
+};
+
+///
+/// Get the total processor demand of jobs that are released and due in [0, length]
+///
+static UInt64 getProcessorDemand(const Task* tasks, size_t count, UInt64 length)
+{
+    UInt64 demand = 0;
+
+    for (size_t index = 0; index < count; index += 1)
+    {
+        if (length >= tasks[index].deadline)
+        {
+            demand += ((length - tasks[index].deadline) / tasks[index].period + 1) * tasks[index].wcet;
+        }
+    }
+
+    return demand;
+}
+
+///
+/// Apply the processor demand criterion
+///
+/// @return `true` if the task set is schedulable under EDF, `false` otherwise.
+///
+static bool analyze(const Task* tasks, size_t count, UInt64 hyperperiod)
+{
+    double utilization = 0;
+
+    double slack = 0;
+
+    UInt32 maxDeadline = 0;
+
+    for (size_t index = 0; index < count; index += 1)
+    {
+        const Task& task = tasks[index];
+
+        double share = static_cast<double>(task.wcet) / task.period;
+
+        utilization += share;
+
+        slack += (static_cast<double>(task.period) - task.deadline) * share;
+
+        maxDeadline = std::max(maxDeadline, task.deadline);
+    }
+
+    printf("Utilization: %.4f\n", utilization);
+
+    if (utilization > 1)
+    {
+        printf("The task set is not schedulable: The processor is overloaded.\n");
+
+        return false;
+    }
+
+    // The demand must be checked at every absolute deadline up to this bound
+    UInt64 bound = hyperperiod;
+
+    if (utilization < 1)
+    {
+        bound = std::min(bound, std::max<UInt64>(maxDeadline, static_cast<UInt64>(slack / (1 - utilization))));
+    }
+
+    for (size_t index = 0; index < count; index += 1)
+    {
+        for (UInt64 length = tasks[index].deadline; length <= bound; length += tasks[index].period)
+        {
+            UInt64 demand = getProcessorDemand(tasks, count, length);
+
+            if (demand > length)
+            {
+                printf("The task set is not schedulable: Jobs due in %" PRIu64 " ms need %" PRIu64 " ms.\n", length, demand);
+
+                return false;
+            }
+        }
+    }
+
+    printf("The task set passes the processor demand criterion (checked up to %" PRIu64 " ms).\n", bound);
+
+    return true;
+}
+
+///
+/// Simulate the task set with the EDF ready queue of the kernel
+///
+/// @return `true` if no job misses its deadline, `false` otherwise.
+///
+static bool simulate(const Task* tasks, size_t count, UInt64 length)
+{
+    struct Job: DeadlineSupport
+    {
+        UInt32 remaining;
+
+        bool pending;
+    };
+
+    struct Statistics
+    {
+        UInt32 completed;
+
+        UInt32 missed;
+
+        UInt32 maxLateness;
+
+        UInt32 overruns;
+    };
+
+    Job jobs[kMaxTasks] = {};
+
+    Statistics statistics[kMaxTasks] = {};
+
+    EarliestDeadlineFirstQueue<Job, kMaxTasks> queue;
+
+    Job* running = nullptr;
+
+    for (size_t index = 0; index < count; index += 1)
+    {
+        jobs[index].relativeDeadline = tasks[index].deadline;
+    }
+
+    for (UInt64 now = 0; now < length; now += 1)
+    {
+        // Release jobs in the same way as the kernel posts events
+        for (size_t index = 0; index < count; index += 1)
+        {
+            Job& job = jobs[index];
+
+            if (now % tasks[index].period != 0)
+            {
+                continue;
+            }
+
+            // The kernel keeps a single control block per event, so a job cannot be released until the previous one completes
+            if (job.pending)
+            {
+                statistics[index].overruns += 1;
+
+                continue;
+            }
+
+            job.release(static_cast<UInt32>(now));
+
+            job.remaining = tasks[index].wcet;
+
+            job.pending = true;
+
+            if (running == nullptr)
+            {
+                running = &job;
+            }
+            else if (DeadlineSupport::precedes(job, *running))
+            {
+                queue.ready(running);
+
+                running = &job;
+            }
+            else
+            {
+                queue.ready(&job);
+            }
+        }
+
+        if (running == nullptr)
+        {
+            continue;
+        }
+
+        running->remaining -= 1;
+
+        if (running->remaining != 0)
+        {
+            continue;
+        }
+
+        Statistics& stats = statistics[running - jobs];
+
+        UInt32 lateness = running->getLateness(static_cast<UInt32>(now + 1));
+
+        stats.completed += 1;
+
+        if (lateness != 0)
+        {
+            stats.missed += 1;
+
+            stats.maxLateness = std::max(stats.maxLateness, lateness);
+        }
+
+        running->pending = false;
+
+        running = queue.isReadyQueueEmpty() ? nullptr : queue.next();
+    }
+
+    printf("Simulated %" PRIu64 " ms:\n", length);
+
+    printf("%-12s %10s %10s %16s %10s\n", "Task", "Completed", "Missed", "Max Late (ms)", "Overruns");
+
+    bool schedulable = true;
+
+    for (size_t index = 0; index < count; index += 1)
+    {
+        const Statistics& stats = statistics[index];
+
+        printf("%-12s %10u %10u %16u %10u\n", tasks[index].name, stats.completed, stats.missed, stats.maxLateness, stats.overruns);
+
+        schedulable = schedulable && stats.missed == 0 && stats.overruns == 0;
+    }
+
+    return schedulable;
+}
+
+int main(int argc, char* argv[])
+{
+    Task tasks[kMaxTasks];
+
+    size_t count = 0;
+
+    if (argc == 1)
+    {
+        for (const Task& task : kDefaultTaskSet)
+        {
+            tasks[count++] = task;
+        }
+    }
+
+    for (int index = 1; index < argc; index += 1)
+    {
+        static char names[kMaxTasks][32];
+
+        Task& task = tasks[count];
+
+        if (count == kMaxTasks ||
+            sscanf(argv[index], "%31[^:]:%u:%u:%u", names[count], &task.wcet, &task.deadline, &task.period) != 4 ||
+            task.wcet == 0 || task.deadline == 0 || task.period == 0 || task.deadline > task.period)
+        {
+            fprintf(stderr, "Invalid or too many tasks: %s\n", argv[index]);
+
+            fprintf(stderr, "Usage: %s [<name>:<wcet>:<deadline>:<period> ...] (deadline <= period)\n", argv[0]);
+
+            return EXIT_FAILURE;
+        }
+
+        task.name = names[count];
+
+        count += 1;
+    }
+
+    UInt64 hyperperiod = 1;
+
+    for (size_t index = 0; index < count; index += 1)
+    {
+        hyperperiod = std::min(std::lcm(hyperperiod, static_cast<UInt64>(tasks[index].period)), kMaxSimulationTime);
+    }
+
+    bool schedulable = analyze(tasks, count, hyperperiod);
+
+    // Simulate two hyperperiods, so that jobs released in the first one that complete in the second one are covered
+    schedulable = simulate(tasks, count, std::min(hyperperiod * 2, kMaxSimulationTime)) && schedulable;
+
+    printf("Result: %s\n", schedulable ? "Schedulable" : "Not schedulable");
+
+    return schedulable ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,20 @@
+//
+//  Types.hpp
+//  WireMonitor
+//
+//  Created by agent on 10/19/26.
+//
+
+#ifndef Types_hpp
+#define Types_hpp
+
+// Host replacement of the Tinkertoy types used by the kernel headers shared with host tools
+#include <cstddef>
+#include <cstdint>
+
+using UInt8 = uint8_t;
+using UInt16 = uint16_t;
+using UInt32 = uint32_t;
+using UInt64 = uint64_t;
+
+#endif /* Types_hpp */
@@ -0,0 +1,126 @@
+//
+//  WireMonitor.cpp
+//  WireMonitor
+//
+//  Created by agent on 10/19/26.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "Message.hpp"
+#include "DataLogRecord.hpp"
+#include "WireProtocol.hpp"
+
+//
+// Usage:
+//
+// Decode frames and legacy messages read from the standard input:
+//     nc localhost 10000 | WireMonitor
+//
+// Encode a frame of readings to the standard output (<type>:<sensor>:<value> ...):
+//     WireMonitor --encode <sequence> 3:0:25 3:1:40 | nc localhost 10000
+//
+
+static void printReading(const WireProtocol::Reading& reading)
+{
+    // Records streamed from the data log and the crash dump are not messages
+    const char* type = DataLogRecord::isLogRecord(reading.type) ?
+                       DataLogRecord::Type2String(static_cast<DataLogRecord::Type>(reading.type)) :
+                       Message::Type2String(static_cast<Message::Type>(reading.type));
+
+    printf("    [%s] Sensor = %u, Value = %u\n", type, reading.sensor, reading.value);
+}
+
+static int decode()
+{
+    // The monitor also shows the legacy messages the kernel still sends (e.g. the user stack address at boot)
+    WireProtocol::Receiver<true> receiver;
+
+    using Status = WireProtocol::Receiver<true>::Status;
+
+    int byte;
+
+    while ((byte = getchar()) != EOF)
+    {
+        switch (receiver.feed(static_cast<UInt8>(byte)))
+        {
+            case Status::kFrame:
+            {
+                const auto& frame = receiver.getFrame();
+
+                printf("Frame #%u with %u reading(s):\n", frame.sequence, frame.count);
+
+                for (size_t index = 0; index < frame.count; index += 1)
+                {
+                    printReading(frame.readings[index]);
+                }
+
+                break;
+            }
+
+            case Status::kLegacyMessage:
+            {
+                const auto& message = receiver.getLegacyMessage();
+
+                printf("Legacy message: [%s] Data = %u\n", Message::Type2String(static_cast<Message::Type>(message.type)), message.value);
+
+                break;
+            }
+
+            case Status::kError:
+                printf("Discarded a malformed frame or message.\n");
+
+                break;
+
+            case Status::kPending:
+                break;
+        }
+
+        fflush(stdout);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static int encode(int argc, char* argv[])
+{
+    WireProtocol::Frame frame = {};
+
+    frame.sequence = static_cast<UInt16>(strtoul(argv[0], nullptr, 0));
+
+    for (int index = 1; index < argc; index += 1)
+    {
+        unsigned int type, sensor, value;
+
+        if (sscanf(argv[index], "%u:%u:%u", &type, &sensor, &value) != 3 || !frame.append(type, sensor, value))
+        {
+            fprintf(stderr, "Invalid or too many readings: %s\n", argv[index]);
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    UInt8 bytes[WireProtocol::kMaxFrameSize];
+
+    fwrite(bytes, 1, WireProtocol::encode(frame, bytes), stdout);
+
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc >= 3 && strcmp(argv[1], "--encode") == 0)
+    {
+        return encode(argc - 2, argv + 2);
+    }
+
+    if (argc != 1)
+    {
+        fprintf(stderr, "Usage: %s [--encode <sequence> <type>:<sensor>:<value> ...]\n", argv[0]);
+
+        return EXIT_FAILURE;
+    }
+
+    return decode();
+}
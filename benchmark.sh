@@ -0,0 +1,46 @@
+#!/bin/sh
+#
+# Compare the size-optimized (Release) and the speed-optimized (ReleaseSpeed) build profiles
+#
+# The script builds the kernel with both profiles and kernel service profiling enabled,
+# prints the flash and SRAM usage of each build and then runs each kernel for a while
+# to collect the number of cycles spent on each kernel service.
+#
+# Usage: ./benchmark.sh [seconds]
+#
+# Environment variables:
+# - BENCHMARK_RUNNER: Command used to run a kernel image (the image path is appended), e.g. ARM FastModel.
+#                     QEMU does not emulate the cycle counter, so the script refuses to report cycles under QEMU
+#                     and only compares the sizes if the runner is QEMU or not set.
+#
+set -e
+
+DURATION=${1:-30}
+RUNNER=${BENCHMARK_RUNNER:-}
+
+case "${RUNNER}" in
+    "" | *qemu*)
+        echo "Cycle counts are only meaningful in ARM FastModel or on real hardware. Will compare the sizes only."
+        RUNNER=""
+        ;;
+esac
+
+export KERNEL_DEMO_BUILD=1
+export KERNEL_PROFILING_BUILD=1
+
+for PROFILE in Release ReleaseSpeed; do
+    BUILD="build-${PROFILE}"
+    cmake -S . -B "${BUILD}" -DCMAKE_BUILD_TYPE="${PROFILE}" > /dev/null
+    cmake --build "${BUILD}" --clean-first --parallel 8 > "${BUILD}/build.log" 2>&1 || { cat "${BUILD}/build.log"; exit 1; }
+done
+
+for PROFILE in Release ReleaseSpeed; do
+    BUILD="build-${PROFILE}"
+    echo "==================== ${PROFILE} ===================="
+    grep -E "^-- +(Flash|SRAM) *:" "${BUILD}/build.log" || true
+    [ -n "${RUNNER}" ] || continue
+    timeout "${DURATION}" ${RUNNER} "${BUILD}/Kernel" > "${BUILD}/run.log" 2>&1 || true
+    # Print the last kernel service statistics reported by the kernel
+    awk '/Kernel Service Cycles/ { report = "" } { report = report $0 "\n" } END { printf "%s", report }' "${BUILD}/run.log" \
+        | sed -n '/Kernel Service Cycles/,/^=*$/p'
+done